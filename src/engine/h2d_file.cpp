@@ -20,11 +20,15 @@
 
 #include "h2d_file.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <cstring>
+#include <utility>
 
 #include "image.h"
+#include "tools.h"
+#include "zzlib.h"
 
 namespace
 {
@@ -34,13 +38,31 @@ namespace
     // 4 bytes - file size
     // 5 bytes - file name
     const size_t minFileSize = 4 + 4 + 4 + 4 + 5 + 1;
+
+    // The last byte of the file identifier is the version of the format:
+    // - version 0 contains a list of files with their names stored right before the data
+    // - version 1 contains a directory of files sorted by hashes of their names followed by all names and the data, files might be compressed
+    const uint8_t legacyFormatVersion = 0;
+    const uint8_t currentFormatVersion = 1;
+
+    // 4 bytes - hash of the file name
+    // 4 bytes - file offset
+    // 4 bytes - size of the stored file
+    // 4 bytes - size of the original file
+    // 4 bytes - size of the file name
+    const size_t directoryEntrySize = 4 + 4 + 4 + 4 + 4;
+
+    uint32_t calculateNameHash( const std::string_view name )
+    {
+        return fheroes2::calculateCRC32( reinterpret_cast<const uint8_t *>( name.data() ), name.size() );
+    }
 }
 
 namespace fheroes2
 {
     bool H2DReader::open( const std::string & path )
     {
-        _fileNameAndOffset.clear();
+        _entries.clear();
         _fileStream.close();
 
         if ( !_fileStream.open( path, "rb" ) ) {
@@ -61,7 +83,9 @@ namespace fheroes2
         if ( _fileStream.get() != 'D' ) {
             return false;
         }
-        if ( _fileStream.get() != '\0' ) {
+
+        const uint8_t formatVersion = _fileStream.get();
+        if ( formatVersion != legacyFormatVersion && formatVersion != currentFormatVersion ) {
             return false;
         }
 
@@ -70,6 +94,79 @@ namespace fheroes2
             return false;
         }
 
+        const bool isDirectoryRead = ( formatVersion == legacyFormatVersion ) ? readLegacyDirectory( fileCount, fileSize ) : readDirectory( fileCount, fileSize );
+        if ( !isDirectoryRead ) {
+            _entries.clear();
+            return false;
+        }
+
+        // Entries of the current format are already sorted. If there are files with the same name, only the first one is accessible.
+        std::stable_sort( _entries.begin(), _entries.end(),
+                          []( const FileEntry & first, const FileEntry & second ) { return first.nameHash < second.nameHash; } );
+
+        return true;
+    }
+
+    bool H2DReader::readDirectory( const uint32_t fileCount, const size_t fileSize )
+    {
+        const size_t directorySize = directoryEntrySize * fileCount;
+        if ( directorySize > fileSize ) {
+            return false;
+        }
+
+        // The whole directory is read at once and then parsed in memory.
+        const std::vector<uint8_t> directory = _fileStream.getRaw( directorySize );
+        if ( directory.size() != directorySize ) {
+            return false;
+        }
+
+        ROStreamBuf directoryStream( directory );
+
+        _entries.resize( fileCount );
+
+        size_t namesSize = 0;
+        std::vector<uint32_t> nameSizes( fileCount );
+
+        for ( uint32_t i = 0; i < fileCount; ++i ) {
+            FileEntry & entry = _entries[i];
+
+            entry.nameHash = directoryStream.getLE32();
+            entry.offset = directoryStream.getLE32();
+            entry.storedSize = directoryStream.getLE32();
+            entry.size = directoryStream.getLE32();
+
+            nameSizes[i] = directoryStream.getLE32();
+            namesSize += nameSizes[i];
+        }
+
+        if ( namesSize > fileSize ) {
+            return false;
+        }
+
+        const std::vector<uint8_t> names = _fileStream.getRaw( namesSize );
+        if ( names.size() != namesSize ) {
+            return false;
+        }
+
+        size_t nameOffset = 0;
+        for ( uint32_t i = 0; i < fileCount; ++i ) {
+            FileEntry & entry = _entries[i];
+
+            entry.name.assign( reinterpret_cast<const char *>( names.data() ) + nameOffset, nameSizes[i] );
+            nameOffset += nameSizes[i];
+
+            if ( entry.storedSize == 0 || entry.size == 0 || static_cast<size_t>( entry.offset ) + entry.storedSize > fileSize || entry.name.empty()
+                 || entry.nameHash != calculateNameHash( entry.name ) ) {
+                // This entry is corrupted. It will never be found.
+                entry.name.clear();
+            }
+        }
+
+        return true;
+    }
+
+    bool H2DReader::readLegacyDirectory( const uint32_t fileCount, const size_t fileSize )
+    {
         for ( uint32_t i = 0; i < fileCount; ++i ) {
             const uint32_t offset = _fileStream.getLE32();
             const uint32_t size = _fileStream.getLE32();
@@ -79,29 +176,76 @@ namespace fheroes2
                 continue;
             }
 
-            _fileNameAndOffset.try_emplace( std::move( name ), std::make_pair( offset, size ) );
+            FileEntry & entry = _entries.emplace_back();
+
+            entry.nameHash = calculateNameHash( name );
+            entry.offset = offset;
+            entry.storedSize = size;
+            entry.size = size;
+            entry.name = std::move( name );
         }
 
         return true;
     }
 
-    std::vector<uint8_t> H2DReader::getFile( const std::string & fileName )
+    H2DReader::FileEntry * H2DReader::findEntry( const std::string_view fileName )
+    {
+        const uint32_t nameHash = calculateNameHash( fileName );
+
+        auto it = std::lower_bound( _entries.begin(), _entries.end(), nameHash, []( const FileEntry & entry, const uint32_t hash ) { return entry.nameHash < hash; } );
+        for ( ; it != _entries.end() && it->nameHash == nameHash; ++it ) {
+            if ( it->name == fileName ) {
+                return &( *it );
+            }
+        }
+
+        return nullptr;
+    }
+
+    const std::vector<uint8_t> & H2DReader::getFile( const std::string_view fileName )
     {
-        const auto it = _fileNameAndOffset.find( fileName );
-        if ( it == _fileNameAndOffset.end() ) {
-            return std::vector<uint8_t>();
+        static const std::vector<uint8_t> emptyFile;
+
+        FileEntry * entry = findEntry( fileName );
+        if ( entry == nullptr ) {
+            return emptyFile;
+        }
+
+        if ( entry->isLoaded ) {
+            return entry->data;
+        }
+
+        entry->isLoaded = true;
+
+        _fileStream.seek( entry->offset );
+
+        std::vector<uint8_t> data = _fileStream.getRaw( entry->storedSize );
+        if ( data.size() != entry->storedSize ) {
+            return emptyFile;
+        }
+
+        if ( entry->storedSize == entry->size ) {
+            entry->data = std::move( data );
+        }
+        else {
+            entry->data = Compression::unzipData( data.data(), data.size(), entry->size );
+            if ( entry->data.size() != entry->size ) {
+                // The file is corrupted.
+                entry->data.clear();
+            }
         }
 
-        _fileStream.seek( it->second.first );
-        return _fileStream.getRaw( it->second.second );
+        return entry->data;
     }
 
     std::set<std::string, std::less<>> H2DReader::getAllFileNames() const
     {
         std::set<std::string, std::less<>> names;
 
-        for ( const auto & value : _fileNameAndOffset ) {
-            names.insert( value.first );
+        for ( const FileEntry & entry : _entries ) {
+            if ( !entry.name.empty() ) {
+                names.insert( entry.name );
+            }
         }
 
         return names;
@@ -114,6 +258,38 @@ namespace fheroes2
             return false;
         }
 
+        struct FileToWrite
+        {
+            uint32_t nameHash{ 0 };
+            const std::string * name{ nullptr };
+            const std::vector<uint8_t> * originalData{ nullptr };
+
+            // Compressed data if it is smaller than the original one.
+            std::vector<uint8_t> compressedData;
+        };
+
+        std::vector<FileToWrite> files;
+        files.reserve( _fileData.size() );
+
+        size_t namesSize = 0;
+
+        for ( const auto & [name, data] : _fileData ) {
+            FileToWrite & file = files.emplace_back();
+
+            file.nameHash = calculateNameHash( name );
+            file.name = &name;
+            file.originalData = &data;
+
+            std::vector<uint8_t> compressedData = Compression::zipData( data.data(), data.size() );
+            if ( !compressedData.empty() && compressedData.size() < data.size() ) {
+                file.compressedData = std::move( compressedData );
+            }
+
+            namesSize += name.size();
+        }
+
+        std::stable_sort( files.begin(), files.end(), []( const FileToWrite & first, const FileToWrite & second ) { return first.nameHash < second.nameHash; } );
+
         StreamFile fileStream;
         if ( !fileStream.open( path, "wb" ) ) {
             return false;
@@ -122,30 +298,33 @@ namespace fheroes2
         fileStream.put( 'H' );
         fileStream.put( '2' );
         fileStream.put( 'D' );
-        fileStream.put( '\0' );
+        fileStream.put( currentFormatVersion );
 
-        fileStream.putLE32( static_cast<uint32_t>( _fileData.size() ) );
+        fileStream.putLE32( static_cast<uint32_t>( files.size() ) );
 
-        // Calculate file info section size.
-        size_t fileInfoSection = ( 4 + 4 ) * _fileData.size();
-        for ( const auto & data : _fileData ) {
-            // 4 byte for string size.
-            fileInfoSection += ( data.first.size() + 4 );
-        }
+        size_t offset = 4 + 4 + directoryEntrySize * files.size() + namesSize;
+        for ( const FileToWrite & file : files ) {
+            const size_t storedSize = file.compressedData.empty() ? file.originalData->size() : file.compressedData.size();
 
-        size_t offset = fileInfoSection + 4 + 4;
-        for ( const auto & data : _fileData ) {
+            fileStream.putLE32( file.nameHash );
             fileStream.putLE32( static_cast<uint32_t>( offset ) );
-            fileStream.putLE32( static_cast<uint32_t>( data.second.size() ) );
-            fileStream << data.first;
-            offset += data.second.size();
+            fileStream.putLE32( static_cast<uint32_t>( storedSize ) );
+            fileStream.putLE32( static_cast<uint32_t>( file.originalData->size() ) );
+            fileStream.putLE32( static_cast<uint32_t>( file.name->size() ) );
+
+            offset += storedSize;
         }
 
-        for ( const auto & data : _fileData ) {
-            fileStream.putRaw( data.second.data(), data.second.size() );
+        for ( const FileToWrite & file : files ) {
+            fileStream.putRaw( file.name->data(), file.name->size() );
         }
 
-        return true;
+        for ( const FileToWrite & file : files ) {
+            const std::vector<uint8_t> & data = file.compressedData.empty() ? *file.originalData : file.compressedData;
+            fileStream.putRaw( data.data(), data.size() );
+        }
+
+        return !fileStream.fail();
     }
 
     bool H2DWriter::add( const std::string & name, const std::vector<uint8_t> & data )
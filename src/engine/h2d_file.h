@@ -25,7 +25,7 @@
 #include <map>
 #include <set>
 #include <string>
-#include <utility>
+#include <string_view>
 #include <vector>
 
 #include "serialize.h"
@@ -35,20 +35,44 @@ namespace fheroes2
     class Sprite;
 
     // Heroes 2 Data (H2D) file format used for storing files needed for the project. This format is not a part of original HoMM II.
+    // The archive contains a directory of files sorted by hashes of their names so a file can be found without building any index
+    // while opening the archive. Files might be stored compressed: they are read and decompressed only on the first request.
+    // Archives of the initial version of the format (with no hashes and compression) are supported as well.
     class H2DReader
     {
     public:
         // Returns true if file opening is successful.
         bool open( const std::string & path );
 
-        // Returns non-empty vector if requested file exists.
-        std::vector<uint8_t> getFile( const std::string & fileName );
+        // Returns non-empty vector if requested file exists. The returned reference remains valid until the archive is reopened.
+        const std::vector<uint8_t> & getFile( const std::string_view fileName );
 
         std::set<std::string, std::less<>> getAllFileNames() const;
 
     private:
-        // Relationship between file name in non-capital letters and its offset from the start of the archive.
-        std::map<std::string, std::pair<uint32_t, uint32_t>, std::less<>> _fileNameAndOffset;
+        struct FileEntry
+        {
+            uint32_t nameHash{ 0 };
+            uint32_t offset{ 0 };
+
+            // The size of the file within the archive. It is smaller than the original size if the file is compressed.
+            uint32_t storedSize{ 0 };
+            uint32_t size{ 0 };
+
+            std::string name;
+
+            // The contents of the file which is read on the first request.
+            std::vector<uint8_t> data;
+            bool isLoaded{ false };
+        };
+
+        bool readDirectory( const uint32_t fileCount, const size_t fileSize );
+        bool readLegacyDirectory( const uint32_t fileCount, const size_t fileSize );
+
+        FileEntry * findEntry( const std::string_view fileName );
+
+        // Entries sorted by hashes of file names.
+        std::vector<FileEntry> _entries;
 
         // Stream for reading h2d file.
         StreamFile _fileStream;
@@ -23,6 +23,7 @@
 
 #include "localevent.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
@@ -70,6 +71,43 @@ namespace
 {
     const uint32_t globalLoopSleepTime{ 1 };
 
+    // The maximum time to wait for new events when no animation is expected. Some dialogs check timers on their own without
+    // informing the event handler, so this value must not be too big.
+    const uint64_t maximumIdleWaitTime{ 100 };
+
+    // Events loop idle time statistics are logged once per this interval.
+    const uint64_t idleTimeReportInterval{ 10000 };
+
+    // Measures the share of time spent by the events loop while waiting for new events and how often it wakes up.
+    // This is an estimation of how idle the CPU is while the application is running.
+    class IdleTimeCounter
+    {
+    public:
+        void addIdleTime( const uint64_t idleTimeMs )
+        {
+            _idleTimeMs += idleTimeMs;
+            ++_wakeUpCount;
+
+            const uint64_t totalTimeMs = _timer.getMs();
+            if ( totalTimeMs < idleTimeReportInterval ) {
+                return;
+            }
+
+            DEBUG_LOG( DBG_ENGINE, DBG_TRACE,
+                       "Events loop has been idle for " << _idleTimeMs * 100 / totalTimeMs << "% of the last " << totalTimeMs << " ms with " << _wakeUpCount
+                                                        << " wake ups." )
+
+            _timer.reset();
+            _idleTimeMs = 0;
+            _wakeUpCount = 0;
+        }
+
+    private:
+        fheroes2::Time _timer;
+        uint64_t _idleTimeMs{ 0 };
+        uint64_t _wakeUpCount{ 0 };
+    };
+
     // If such or more ms has passed after pressing the mouse button, then this is a long press.
     const uint32_t mouseButtonLongPressTimeout{ 850 };
 
@@ -422,6 +460,12 @@ namespace EventProcessing
             SDL_Delay( milliseconds );
         }
 
+        // Waits until a new event arrives or the given time passes. The event is not removed from the queue.
+        static void waitForEvent( const uint32_t milliseconds )
+        {
+            SDL_WaitEventTimeout( nullptr, static_cast<int>( milliseconds ) );
+        }
+
         bool handleEvents( LocalEvent & eventHandler, const bool allowExit, bool & updateDisplay )
         {
             updateDisplay = false;
@@ -1229,10 +1273,22 @@ bool LocalEvent::HandleEvents( const bool sleepAfterEventProcessing, const bool
             display.render( renderRoi );
         }
 
+        static IdleTimeCounter idleTimeCounter;
+
+        const uint64_t processingTime = eventProcessingTimer.getMs();
+        const uint64_t idleWaitTime = getIdleWaitTime();
+
+        // If nothing is going to happen for a while there is no need to wake up until a new event arrives.
+        if ( idleWaitTime > processingTime + globalLoopSleepTime ) {
+            const fheroes2::Time idleTimer;
+            EventProcessing::EventEngine::waitForEvent( static_cast<uint32_t>( idleWaitTime - processingTime ) );
+            idleTimeCounter.addIdleTime( idleTimer.getMs() );
+        }
         // Make sure not to delay any further if the processing time within this function was more than the expected waiting time.
-        if ( eventProcessingTimer.getMs() < globalLoopSleepTime ) {
+        else if ( processingTime < globalLoopSleepTime ) {
             static_assert( globalLoopSleepTime == 1, "Make sure that you sleep for the difference between times since you change the sleep time." );
             EventProcessing::EventEngine::sleep( globalLoopSleepTime );
+            idleTimeCounter.addIdleTime( globalLoopSleepTime );
         }
     }
     else {
@@ -1242,9 +1298,34 @@ bool LocalEvent::HandleEvents( const bool sleepAfterEventProcessing, const bool
         }
     }
 
+    _idleWaitTimeLimit.reset();
+
     return true;
 }
 
+void LocalEvent::limitNextIdleWaitTime( const uint64_t timeMs )
+{
+    _idleWaitTimeLimit = _idleWaitTimeLimit ? std::min( *_idleWaitTimeLimit, timeMs ) : timeMs;
+}
+
+uint64_t LocalEvent::getIdleWaitTime() const
+{
+    // Held mouse buttons and keys as well as tilted controller sticks are processed continuously even without new events.
+    if ( ( _actionStates & ( MOUSE_PRESSED | KEY_HOLD ) ) || _controllerLeftXAxis != 0 || _controllerLeftYAxis != 0 || _controllerRightXAxis != 0
+         || _controllerRightYAxis != 0 ) {
+        return 0;
+    }
+
+    uint64_t waitTime = _idleWaitTimeLimit ? std::min( *_idleWaitTimeLimit, maximumIdleWaitTime ) : maximumIdleWaitTime;
+
+    const std::optional<uint64_t> cyclingUpdateTime = fheroes2::RenderProcessor::instance().getTimeUntilCyclingUpdate();
+    if ( cyclingUpdateTime ) {
+        waitTime = std::min( waitTime, *cyclingUpdateTime );
+    }
+
+    return waitTime;
+}
+
 void LocalEvent::StopSounds()
 {
     Audio::Mute();
@@ -209,9 +209,14 @@ public:
         _globalKeyDownEventHook = std::move( hook );
     }
 
-    // Return false when event handling should be stopped, true otherwise.
+    // Return false when event handling should be stopped, true otherwise. If sleeping is allowed and nothing is expected
+    // to happen for a while, this method waits for new events instead of returning immediately.
     bool HandleEvents( const bool sleepAfterEventProcessing = true, const bool allowExit = false );
 
+    // Limits the time the next call of HandleEvents() can wait for new events. This should be called with the time left until
+    // the next animation frame, otherwise the animation might be delayed while there are no events.
+    void limitNextIdleWaitTime( const uint64_t timeMs );
+
     bool hasMouseMoved() const
     {
         return ( _actionStates & MOUSE_MOTION ) == MOUSE_MOTION;
@@ -492,6 +497,9 @@ private:
     // Is the two-finger gesture currently being processed
     bool _isTwoFingerGestureInProgress = false;
 
+    // The maximum time the next call of HandleEvents() can wait for new events, if set.
+    std::optional<uint64_t> _idleWaitTimeLimit;
+
     static void StopSounds();
     static void ResumeSounds();
 
@@ -509,6 +517,9 @@ private:
 
     void ProcessControllerAxisMotion();
 
+    // Returns the time in milliseconds during which there is no need to process events unless a new event arrives.
+    uint64_t getIdleWaitTime() const;
+
     void setStates( const uint32_t states )
     {
         _actionStates |= states;
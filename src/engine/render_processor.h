@@ -22,6 +22,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <optional>
 #include <vector>
 
 #include "timing.h"
@@ -79,6 +80,17 @@ namespace fheroes2
             return _enableCycling && _lastRenderCall.getMs() >= _cyclingInterval;
         }
 
+        // Returns the time in milliseconds left until the next color cycling update or nothing if color cycling is disabled.
+        std::optional<uint64_t> getTimeUntilCyclingUpdate() const
+        {
+            if ( !_enableCycling ) {
+                return {};
+            }
+
+            const uint64_t passedMs = _lastRenderCall.getMs();
+            return passedMs >= _cyclingInterval ? 0 : _cyclingInterval - passedMs;
+        }
+
     private:
         RenderProcessor() = default;
 
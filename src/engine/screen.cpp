@@ -19,6 +19,7 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstdint>
@@ -264,8 +265,13 @@ namespace
     {
     protected:
         std::vector<uint32_t> _palette32Bit;
+        std::vector<uint32_t> _previousPalette32Bit;
         std::vector<SDL_Color> _palette8Bit;
 
+        // Flags of 32-bit palette colors which have been changed by palette updates since the last time pixels of these colors were uploaded.
+        // Several palette updates can happen between two renders, so the flags are accumulated until they are reset.
+        std::array<uint8_t, 256> _isPaletteColorChanged{};
+
         void copyImageToSurface( const fheroes2::Image & image, SDL_Surface * surface, const fheroes2::Rect & roi )
         {
             assert( surface != nullptr && !image.empty() );
@@ -337,11 +343,57 @@ namespace
                 SDL_UnlockSurface( surface );
         }
 
+        // Returns the area of the image which contains all pixels with colors changed by palette updates since the last reset of the flags.
+        // The area is empty if there are no such pixels.
+        fheroes2::Rect getChangedColorsArea( const fheroes2::Image & image ) const
+        {
+            assert( !image.empty() );
+
+            const int32_t imageWidth = image.width();
+            const int32_t imageHeight = image.height();
+
+            int32_t minX = imageWidth;
+            int32_t maxX = -1;
+            int32_t minY = imageHeight;
+            int32_t maxY = -1;
+
+            const uint8_t * inY = image.image();
+            const uint8_t * isColorChanged = _isPaletteColorChanged.data();
+
+            for ( int32_t y = 0; y < imageHeight; ++y, inY += imageWidth ) {
+                int32_t x = 0;
+                while ( x < imageWidth && isColorChanged[inY[x]] == 0 ) {
+                    ++x;
+                }
+
+                if ( x == imageWidth ) {
+                    continue;
+                }
+
+                int32_t lastX = imageWidth - 1;
+                while ( isColorChanged[inY[lastX]] == 0 ) {
+                    --lastX;
+                }
+
+                minX = std::min( minX, x );
+                maxX = std::max( maxX, lastX );
+                minY = std::min( minY, y );
+                maxY = y;
+            }
+
+            if ( maxX < 0 ) {
+                return {};
+            }
+
+            return { minX, minY, maxX - minX + 1, maxY - minY + 1 };
+        }
+
         void generatePalette( const std::vector<uint8_t> & colorIds, const SDL_Surface * surface )
         {
             assert( surface != nullptr );
 
             if ( surface->format->BitsPerPixel == 32 ) {
+                _previousPalette32Bit.swap( _palette32Bit );
                 _palette32Bit.resize( 256u );
 
                 if ( surface->format->Amask > 0 ) {
@@ -356,6 +408,13 @@ namespace
                         _palette32Bit[i] = SDL_MapRGB( surface->format, *value, *( value + 1 ), *( value + 2 ) );
                     }
                 }
+
+                const bool isPreviousPaletteValid = ( _previousPalette32Bit.size() == _palette32Bit.size() );
+                for ( size_t i = 0; i < 256u; ++i ) {
+                    if ( !isPreviousPaletteValid || _previousPalette32Bit[i] != _palette32Bit[i] ) {
+                        _isPaletteColorChanged[i] = 1;
+                    }
+                }
             }
             else if ( surface->format->BitsPerPixel == 8 ) {
                 _palette8Bit.resize( 256 );
@@ -1034,41 +1093,36 @@ namespace
                 return;
             }
 
-            copyImageToSurface( display, _surface, roi );
-
-            const bool fullFrame = ( roi.width == display.width() ) && ( roi.height == display.height() );
-            if ( fullFrame ) {
-                const int returnCode = SDL_UpdateTexture( _texture, nullptr, _surface->pixels, _surface->pitch );
-                if ( returnCode < 0 ) {
-                    ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
-                }
-            }
-            else {
-                SDL_Rect area;
-                area.x = roi.x;
-                area.y = roi.y;
-                area.w = roi.width;
-                area.h = roi.height;
+            _updateTexture( display, roi );
+            _present();
 
-                const int returnCode = SDL_UpdateTexture( _texture, &area, _surface->pixels, _surface->pitch );
-                if ( returnCode < 0 ) {
-                    ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
-                }
+            if ( roi.width == display.width() && roi.height == display.height() ) {
+                // All pixels have been uploaded with the current palette.
+                _isPaletteColorChanged.fill( 0 );
             }
+        }
 
-            int returnCode = SDL_RenderClear( _renderer );
-            if ( returnCode < 0 ) {
-                ERROR_LOG( "Failed to clear renderer. The error value: " << returnCode << ", description: " << SDL_GetError() )
+        void renderAfterPaletteChange( const fheroes2::Display & display, const fheroes2::Rect & roi ) override
+        {
+            const bool fullFrame = ( roi.width == display.width() ) && ( roi.height == display.height() );
+            if ( fullFrame || _surface == nullptr || _texture == nullptr || _surface->format->BitsPerPixel != 32 ) {
+                render( display, { 0, 0, display.width(), display.height() } );
                 return;
             }
 
-            returnCode = SDL_RenderCopy( _renderer, _texture, nullptr, nullptr );
-            if ( returnCode < 0 ) {
-                ERROR_LOG( "Failed to copy render.The error value: " << returnCode << ", description: " << SDL_GetError() )
-                return;
+            // Color cycling changes only a few palette colors, so there is no need to convert and upload the whole frame:
+            // only the area with pixels of these colors is updated in addition to the area which has been changed in the image itself.
+            const fheroes2::Rect changedColorsRoi = getChangedColorsArea( display );
+
+            _updateTexture( display, roi );
+
+            if ( changedColorsRoi.width > 0 && changedColorsRoi.height > 0 ) {
+                _updateTexture( display, changedColorsRoi );
             }
 
-            SDL_RenderPresent( _renderer );
+            _isPaletteColorChanged.fill( 0 );
+
+            _present();
         }
 
         bool allocate( fheroes2::ResolutionInfo & resolutionInfo, bool isFullScreen ) override
@@ -1202,6 +1256,48 @@ namespace
             return SDL_RENDERER_ACCELERATED;
         }
 
+        void _updateTexture( const fheroes2::Display & display, const fheroes2::Rect & roi )
+        {
+            copyImageToSurface( display, _surface, roi );
+
+            const bool fullFrame = ( roi.width == display.width() ) && ( roi.height == display.height() );
+            if ( fullFrame ) {
+                const int returnCode = SDL_UpdateTexture( _texture, nullptr, _surface->pixels, _surface->pitch );
+                if ( returnCode < 0 ) {
+                    ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
+                }
+            }
+            else {
+                SDL_Rect area;
+                area.x = roi.x;
+                area.y = roi.y;
+                area.w = roi.width;
+                area.h = roi.height;
+
+                const int returnCode = SDL_UpdateTexture( _texture, &area, _surface->pixels, _surface->pitch );
+                if ( returnCode < 0 ) {
+                    ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
+                }
+            }
+        }
+
+        void _present()
+        {
+            int returnCode = SDL_RenderClear( _renderer );
+            if ( returnCode < 0 ) {
+                ERROR_LOG( "Failed to clear renderer. The error value: " << returnCode << ", description: " << SDL_GetError() )
+                return;
+            }
+
+            returnCode = SDL_RenderCopy( _renderer, _texture, nullptr, nullptr );
+            if ( returnCode < 0 ) {
+                ERROR_LOG( "Failed to copy render.The error value: " << returnCode << ", description: " << SDL_GetError() )
+                return;
+            }
+
+            SDL_RenderPresent( _renderer );
+        }
+
         void _createPalette()
         {
             if ( _surface == nullptr )
@@ -1340,6 +1436,11 @@ namespace
 
 namespace fheroes2
 {
+    void BaseRenderEngine::renderAfterPaletteChange( const Display & display, const Rect & /*unused*/ )
+    {
+        render( display, { 0, 0, display.width(), display.height() } );
+    }
+
     void BaseRenderEngine::linkRenderSurface( uint8_t * surface ) const
     {
         Display::instance().linkRenderSurface( surface );
@@ -1451,8 +1552,8 @@ namespace fheroes2
                 // when we change a palette for 8-bit image we unwillingly call render so we don't need to re-render the same frame again
                 updateImage = ( _renderSurface == nullptr );
                 if ( updateImage ) {
-                    // Pre-processing step is applied to the whole image so we forcefully render the full frame.
-                    _engine->render( *this, { 0, 0, width(), height() } );
+                    // Pre-processing step is applied to the whole image so the engine has to render all pixels affected by the new palette.
+                    _engine->renderAfterPaletteChange( *this, roi );
                     return;
                 }
             }
@@ -173,6 +173,10 @@ namespace fheroes2
             // Do nothing.
         }
 
+        // Renders the image after the palette has been updated. The given area has been changed in the image itself.
+        // Since the palette affects the whole image the full frame is rendered by default.
+        virtual void renderAfterPaletteChange( const Display & display, const Rect & roi );
+
         void linkRenderSurface( uint8_t * surface ) const; // declaration of this method is in source file
 
     private:
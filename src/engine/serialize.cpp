@@ -35,6 +35,8 @@
 namespace
 {
     const size_t minBufferCapacity = 1024;
+
+    const size_t fileBufferSize = 32 * 1024;
 }
 
 StreamBase::StreamBase( StreamBase && stream ) noexcept
@@ -154,7 +156,8 @@ IStreamBase & IStreamBase::operator>>( std::string & v )
 {
     v.resize( get32() );
 
-    std::for_each( v.begin(), v.end(), [this]( char & item ) { item = get8(); } );
+    // A string is a container of bytes so it doesn't matter which endianess is being used.
+    readRaw( v.data(), v.size() );
 
     return *this;
 }
@@ -394,12 +397,27 @@ ROStreamBuf::ROStreamBuf( const std::vector<uint8_t> & buf )
     setBigendian( IS_BIGENDIAN );
 }
 
+StreamFile::~StreamFile()
+{
+    close();
+}
+
 bool StreamFile::open( const std::string & fn, const std::string & mode )
 {
+    close();
+
     _file.reset( std::fopen( fn.c_str(), mode.c_str() ) );
     if ( !_file ) {
         ERROR_LOG( "Error opening file " << fn )
     }
+    else {
+        // The stream has its own buffer, there is no need to buffer the data twice
+        std::setvbuf( _file.get(), nullptr, _IONBF, 0 );
+
+        if ( !_buffer ) {
+            _buffer = std::make_unique<uint8_t[]>( fileBufferSize );
+        }
+    }
 
     setFail( !_file );
 
@@ -408,6 +426,8 @@ bool StreamFile::open( const std::string & fn, const std::string & mode )
 
 void StreamFile::close()
 {
+    syncBuffer();
+
     _file.reset();
 }
 
@@ -417,6 +437,8 @@ size_t StreamFile::size()
         return 0;
     }
 
+    syncBuffer();
+
     const long pos = std::ftell( _file.get() );
     if ( pos < 0 ) {
         setFail( true );
@@ -457,6 +479,8 @@ void StreamFile::seek( size_t pos )
         return;
     }
 
+    syncBuffer();
+
     if ( std::fseek( _file.get(), static_cast<long>( pos ), SEEK_SET ) != 0 ) {
         setFail( true );
     }
@@ -468,6 +492,8 @@ size_t StreamFile::sizeg()
         return 0;
     }
 
+    syncBuffer();
+
     const long pos = std::ftell( _file.get() );
     if ( pos < 0 ) {
         setFail( true );
@@ -517,6 +543,15 @@ size_t StreamFile::tellg()
         return 0;
     }
 
+    // Take into account the data in the buffer
+    if ( _bufferMode == BufferMode::READ ) {
+        return static_cast<size_t>( pos ) - ( _bufferEnd - _bufferPos );
+    }
+
+    if ( _bufferMode == BufferMode::WRITE ) {
+        return static_cast<size_t>( pos ) + _bufferEnd;
+    }
+
     return static_cast<size_t>( pos );
 }
 
@@ -536,6 +571,15 @@ void StreamFile::skip( size_t pos )
         return;
     }
 
+    // Short skips can be done within the buffer
+    if ( _bufferMode == BufferMode::READ && pos <= _bufferEnd - _bufferPos ) {
+        _bufferPos += pos;
+
+        return;
+    }
+
+    syncBuffer();
+
     if ( std::fseek( _file.get(), static_cast<long int>( pos ), SEEK_CUR ) != 0 ) {
         setFail( true );
     }
@@ -600,7 +644,7 @@ std::vector<uint8_t> StreamFile::getRaw( const size_t size )
 
     std::vector<uint8_t> v( chunkSize );
 
-    if ( std::fread( v.data(), chunkSize, 1, _file.get() ) != 1 ) {
+    if ( !readBuffered( v.data(), chunkSize ) ) {
         setFail( true );
 
         return {};
@@ -620,11 +664,130 @@ void StreamFile::putRaw( const void * ptr, size_t sz )
         return;
     }
 
-    if ( std::fwrite( ptr, sz, 1, _file.get() ) != 1 ) {
+    if ( !writeBuffered( ptr, sz ) ) {
+        setFail( true );
+    }
+}
+
+void StreamFile::readRaw( void * ptr, const size_t size )
+{
+    if ( size == 0 ) {
+        return;
+    }
+
+    if ( !_file ) {
+        std::memset( ptr, 0, size );
+
+        return;
+    }
+
+    if ( !readBuffered( ptr, size ) ) {
+        std::memset( ptr, 0, size );
+
         setFail( true );
     }
 }
 
+bool StreamFile::readBuffered( void * ptr, size_t size )
+{
+    assert( _file && _buffer );
+
+    if ( _bufferMode != BufferMode::READ ) {
+        syncBuffer();
+
+        _bufferMode = BufferMode::READ;
+    }
+
+    uint8_t * dst = static_cast<uint8_t *>( ptr );
+
+    while ( size > 0 ) {
+        if ( _bufferPos < _bufferEnd ) {
+            const size_t sizeToCopy = std::min( size, _bufferEnd - _bufferPos );
+
+            std::memcpy( dst, _buffer.get() + _bufferPos, sizeToCopy );
+
+            _bufferPos += sizeToCopy;
+            dst += sizeToCopy;
+            size -= sizeToCopy;
+
+            continue;
+        }
+
+        // Large blocks of data are read directly, bypassing the buffer
+        if ( size >= fileBufferSize ) {
+            return std::fread( dst, size, 1, _file.get() ) == 1;
+        }
+
+        _bufferPos = 0;
+        _bufferEnd = std::fread( _buffer.get(), 1, fileBufferSize, _file.get() );
+
+        if ( _bufferEnd == 0 ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool StreamFile::writeBuffered( const void * ptr, size_t size )
+{
+    assert( _file && _buffer );
+
+    if ( _bufferMode != BufferMode::WRITE ) {
+        syncBuffer();
+
+        _bufferMode = BufferMode::WRITE;
+    }
+
+    if ( size > fileBufferSize - _bufferEnd ) {
+        const size_t pendingSize = _bufferEnd;
+
+        _bufferEnd = 0;
+
+        if ( pendingSize > 0 && std::fwrite( _buffer.get(), pendingSize, 1, _file.get() ) != 1 ) {
+            return false;
+        }
+
+        // Large blocks of data are written directly, bypassing the buffer
+        if ( size >= fileBufferSize ) {
+            return std::fwrite( ptr, size, 1, _file.get() ) == 1;
+        }
+    }
+
+    std::memcpy( _buffer.get() + _bufferEnd, ptr, size );
+
+    _bufferEnd += size;
+
+    return true;
+}
+
+void StreamFile::syncBuffer()
+{
+    if ( _file ) {
+        if ( _bufferMode == BufferMode::READ ) {
+            // Return the file position to the first byte that has not been consumed yet. This call is also required by the
+            // C standard before switching from reading to writing.
+            if ( std::fseek( _file.get(), -static_cast<long>( _bufferEnd - _bufferPos ), SEEK_CUR ) != 0 ) {
+                setFail( true );
+            }
+        }
+        else if ( _bufferMode == BufferMode::WRITE ) {
+            if ( _bufferEnd > 0 && std::fwrite( _buffer.get(), _bufferEnd, 1, _file.get() ) != 1 ) {
+                setFail( true );
+            }
+
+            // This call is required by the C standard before switching from writing to reading
+            if ( std::fflush( _file.get() ) != 0 ) {
+                setFail( true );
+            }
+        }
+    }
+
+    _bufferMode = BufferMode::NONE;
+    _bufferPos = 0;
+    _bufferEnd = 0;
+}
+
 RWStreamBuf StreamFile::toStreamBuf( const size_t size /* = 0 */ )
 {
     const size_t chunkSize = size > 0 ? size : sizeg();
@@ -634,7 +797,7 @@ RWStreamBuf StreamFile::toStreamBuf( const size_t size /* = 0 */ )
 
     RWStreamBuf buffer( chunkSize );
 
-    if ( std::fread( buffer.rwData(), chunkSize, 1, _file.get() ) != 1 ) {
+    if ( !readBuffered( buffer.rwData(), chunkSize ) ) {
         setFail( true );
 
         return {};
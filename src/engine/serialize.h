@@ -138,6 +138,28 @@ protected:
 
     void setFail( bool f );
 
+    // Types that are (de)serialized as a contiguous block of memory instead of element by element when stored in containers.
+    // This list should only contain types that have the corresponding operators defined. 'bool' is not one of them because any
+    // non-zero value is deserialized as 'true'.
+    template <typename T>
+    static constexpr bool isBulkSerializable = std::is_same_v<T, char> || std::is_same_v<T, int8_t> || std::is_same_v<T, uint8_t> || std::is_same_v<T, int16_t>
+                                               || std::is_same_v<T, uint16_t> || std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t>;
+
+    // Returns true if the byte order of the stream does not match the byte order of the system
+    bool isByteSwapRequired() const
+    {
+        return bigendian() != IS_BIGENDIAN;
+    }
+
+    template <typename T>
+    static T swapByteOrder( T value )
+    {
+        uint8_t * bytes = reinterpret_cast<uint8_t *>( &value );
+        std::reverse( bytes, bytes + sizeof( T ) );
+
+        return value;
+    }
+
 private:
     enum : uint32_t
     {
@@ -199,7 +221,12 @@ public:
     {
         v.resize( get32() );
 
-        std::for_each( v.begin(), v.end(), [this]( auto & item ) { *this >> item; } );
+        if constexpr ( isBulkSerializable<Type> ) {
+            getBulk( v.data(), v.size() );
+        }
+        else {
+            std::for_each( v.begin(), v.end(), [this]( auto & item ) { *this >> item; } );
+        }
 
         return *this;
     }
@@ -244,7 +271,12 @@ public:
             return *this;
         }
 
-        std::for_each( v.begin(), v.end(), [this]( auto & item ) { *this >> item; } );
+        if constexpr ( isBulkSerializable<Type> ) {
+            getBulk( v.data(), v.size() );
+        }
+        else {
+            std::for_each( v.begin(), v.end(), [this]( auto & item ) { *this >> item; } );
+        }
 
         return *this;
     }
@@ -263,6 +295,24 @@ protected:
 
     virtual uint8_t get8() = 0;
 
+    // Reads exactly the given number of bytes to the given buffer. If there is not enough data, the rest of the buffer is filled
+    // with zeros.
+    virtual void readRaw( void * ptr, const size_t size ) = 0;
+
+    template <class Type>
+    void getBulk( Type * data, const size_t count )
+    {
+        static_assert( isBulkSerializable<Type> );
+
+        readRaw( data, count * sizeof( Type ) );
+
+        if constexpr ( sizeof( Type ) > 1 ) {
+            if ( isByteSwapRequired() ) {
+                std::transform( data, data + count, data, swapByteOrder<Type> );
+            }
+        }
+    }
+
     virtual size_t sizeg() = 0;
     virtual size_t tellg() = 0;
 };
@@ -315,7 +365,12 @@ public:
     {
         put32( static_cast<uint32_t>( v.size() ) );
 
-        std::for_each( v.begin(), v.end(), [this]( const auto & item ) { *this << item; } );
+        if constexpr ( isBulkSerializable<Type> ) {
+            putBulk( v.data(), v.size() );
+        }
+        else {
+            std::for_each( v.begin(), v.end(), [this]( const auto & item ) { *this << item; } );
+        }
 
         return *this;
     }
@@ -345,7 +400,12 @@ public:
     {
         put32( static_cast<uint32_t>( v.size() ) );
 
-        std::for_each( v.begin(), v.end(), [this]( const auto & item ) { *this << item; } );
+        if constexpr ( isBulkSerializable<Type> ) {
+            putBulk( v.data(), v.size() );
+        }
+        else {
+            std::for_each( v.begin(), v.end(), [this]( const auto & item ) { *this << item; } );
+        }
 
         return *this;
     }
@@ -357,6 +417,31 @@ protected:
 
     virtual void put8( const uint8_t ) = 0;
 
+    template <class Type>
+    void putBulk( const Type * data, const size_t count )
+    {
+        static_assert( isBulkSerializable<Type> );
+
+        if constexpr ( sizeof( Type ) > 1 ) {
+            if ( isByteSwapRequired() ) {
+                // Convert the data in small portions to avoid making a copy of the whole container
+                std::array<Type, 256> temp;
+
+                for ( size_t i = 0; i < count; i += temp.size() ) {
+                    const size_t portionSize = std::min( temp.size(), count - i );
+
+                    std::transform( data + i, data + i + portionSize, temp.begin(), swapByteOrder<Type> );
+
+                    putRaw( temp.data(), portionSize * sizeof( Type ) );
+                }
+
+                return;
+            }
+        }
+
+        putRaw( data, count * sizeof( Type ) );
+    }
+
     virtual size_t sizep() = 0;
     virtual size_t tellp() = 0;
 };
@@ -524,6 +609,23 @@ protected:
         return 0;
     }
 
+    void readRaw( void * ptr, const size_t size ) override
+    {
+        uint8_t * dst = static_cast<uint8_t *>( ptr );
+
+        const size_t sizeToCopy = std::min( size, sizeg() );
+
+        std::copy( _itget, _itget + sizeToCopy, dst );
+
+        _itget += sizeToCopy;
+
+        if ( sizeToCopy < size ) {
+            std::fill( dst + sizeToCopy, dst + size, static_cast<uint8_t>( 0 ) );
+
+            setFail( true );
+        }
+    }
+
     size_t capacity() const
     {
         return _itend - _itbeg;
@@ -598,7 +700,8 @@ public:
     ROStreamBuf & operator=( const ROStreamBuf & ) = delete;
 };
 
-// Stream with a file storage backend that supports both reading and writing
+// Stream with a file storage backend that supports both reading and writing. Reads and writes are done through the internal
+// buffer to avoid calling the C library for every single value.
 class StreamFile final : public IStreamBase, public OStreamBase
 {
 public:
@@ -606,7 +709,7 @@ public:
 
     StreamFile( const StreamFile & ) = delete;
 
-    ~StreamFile() override = default;
+    ~StreamFile() override;
 
     StreamFile & operator=( const StreamFile & ) = delete;
 
@@ -649,6 +752,17 @@ private:
     uint8_t get8() override;
     void put8( const uint8_t v ) override;
 
+    void readRaw( void * ptr, const size_t size ) override;
+
+    // Reads the data using the internal buffer. Returns false if not all the requested data has been read.
+    bool readBuffered( void * ptr, size_t size );
+    // Writes the data using the internal buffer. Returns false on error.
+    bool writeBuffered( const void * ptr, size_t size );
+
+    // Writes all the pending data to the file or discards the data that was read ahead but not consumed, so that the position
+    // of the file matches the logical position of the stream.
+    void syncBuffer();
+
     template <typename T>
     T getUint()
     {
@@ -658,7 +772,7 @@ private:
 
         T val;
 
-        if ( std::fread( &val, sizeof( T ), 1, _file.get() ) != 1 ) {
+        if ( !readBuffered( &val, sizeof( T ) ) ) {
             setFail( true );
 
             return 0;
@@ -674,12 +788,27 @@ private:
             return;
         }
 
-        if ( std::fwrite( &val, sizeof( T ), 1, _file.get() ) != 1 ) {
+        if ( !writeBuffered( &val, sizeof( T ) ) ) {
             setFail( true );
         }
     }
 
+    enum class BufferMode : uint8_t
+    {
+        NONE,
+        READ,
+        WRITE
+    };
+
     std::unique_ptr<std::FILE, int ( * )( std::FILE * )> _file{ nullptr, []( std::FILE * f ) { return std::fclose( f ); } };
+
+    std::unique_ptr<uint8_t[]> _buffer;
+
+    // In the READ mode, the buffer contains the data in the range [_bufferPos, _bufferEnd) that was read from the file but not
+    // consumed yet. In the WRITE mode, the buffer contains the data in the range [0, _bufferEnd) that is not written to the file yet.
+    BufferMode _bufferMode{ BufferMode::NONE };
+    size_t _bufferPos{ 0 };
+    size_t _bufferEnd{ 0 };
 };
 
 namespace fheroes2
@@ -21,16 +21,20 @@
 #include "smk_decoder.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <memory>
+#include <mutex>
 
 #include "exception.h"
 #include "image.h"
 #include "serialize.h"
 #include "smacker.h"
+#include "thread.h"
 
 namespace
 {
@@ -58,10 +62,240 @@ namespace
             throw fheroes2::InvalidDataResources( "Video file " + filePath + " is being corrupted. Make sure that you own an official version of the game." );
         }
     }
+
+    // The audio is decoded using a separate instance of the video file reading it directly from the disk, so it does not interfere
+    // with the decoding of video frames which might happen at the same time.
+    std::vector<std::vector<uint8_t>> decodeAudioChannels( const std::string & filePath )
+    {
+        const std::unique_ptr<smk_t, void ( * )( smk_t * )> audioFile( smk_open_file( filePath.c_str(), SMK_MODE_DISK ), []( smk_t * f ) { smk_close( f ); } );
+        if ( !audioFile ) {
+            return {};
+        }
+
+        const uint8_t audioChannelCount = 7;
+
+        uint8_t trackMask = 0;
+        uint8_t channelsPerTrack[audioChannelCount] = { 0 };
+        uint8_t audioBitDepth[audioChannelCount] = { 0 };
+        unsigned long audioRate[audioChannelCount] = { 0 };
+        std::vector<std::vector<uint8_t>> soundBuffer( audioChannelCount );
+
+        unsigned long frameCount = 0;
+
+        smk_info_all( audioFile.get(), nullptr, &frameCount, nullptr );
+        smk_info_audio( audioFile.get(), &trackMask, channelsPerTrack, audioBitDepth, audioRate );
+
+        for ( uint8_t i = 0; i < audioChannelCount; ++i ) {
+            if ( trackMask & ( 1 << i ) ) {
+                smk_enable_audio( audioFile.get(), i, 1 );
+            }
+        }
+
+        smk_enable_video( audioFile.get(), 0 ); // disable video reading
+        smk_first( audioFile.get() );
+
+        for ( unsigned long currentFrame = 0; currentFrame < frameCount; ++currentFrame ) {
+            if ( currentFrame > 0 ) {
+                smk_next( audioFile.get() );
+            }
+
+            for ( uint8_t i = 0; i < audioChannelCount; ++i ) {
+                if ( trackMask & ( 1 << i ) ) {
+                    const unsigned long length = smk_get_audio_size( audioFile.get(), i );
+                    if ( length == 0 ) {
+                        continue;
+                    }
+
+                    if ( soundBuffer[i].empty() ) {
+                        soundBuffer[i].resize( audioHeaderSize );
+                    }
+
+                    const uint8_t * data = smk_get_audio( audioFile.get(), i );
+                    soundBuffer[i].insert( soundBuffer[i].end(), data, data + length );
+                }
+            }
+        }
+
+        std::vector<std::vector<uint8_t>> audioChannels;
+
+        // Compose the soundtrack
+        for ( size_t i = 0; i < soundBuffer.size(); ++i ) {
+            if ( soundBuffer[i].empty() ) {
+                continue;
+            }
+
+            std::vector<uint8_t> & wavData = audioChannels.emplace_back();
+            std::swap( wavData, soundBuffer[i] );
+
+            const uint32_t originalSize = static_cast<uint32_t>( wavData.size() - audioHeaderSize );
+
+            RWStreamBuf wavHeader( audioHeaderSize );
+            wavHeader.putLE32( 0x46464952 ); // RIFF marker ("RIFF")
+            wavHeader.putLE32( originalSize + 0x24 ); // Total size minus the size of this and previous fields
+            wavHeader.putLE32( 0x45564157 ); // File type header ("WAVE")
+            wavHeader.putLE32( 0x20746D66 ); // Format sub-chunk marker ("fmt ")
+            wavHeader.putLE32( 0x10 ); // Size of the format sub-chunk
+            wavHeader.putLE16( 0x01 ); // Audio format (1 for PCM)
+            wavHeader.putLE16( channelsPerTrack[i] ); // Number of channels
+            wavHeader.putLE32( audioRate[i] ); // Sample rate
+            wavHeader.putLE32( audioRate[i] * audioBitDepth[i] * channelsPerTrack[i] / 8 ); // Byte rate
+            wavHeader.putLE16( audioBitDepth[i] * channelsPerTrack[i] / 8 ); // Block align
+            wavHeader.putLE16( audioBitDepth[i] ); // Bits per sample
+            wavHeader.putLE32( 0x61746164 ); // Data sub-chunk marker ("data")
+            wavHeader.putLE32( originalSize ); // Size of the data sub-chunk
+
+            memcpy( wavData.data(), wavHeader.data(), audioHeaderSize );
+        }
+
+        return audioChannels;
+    }
 }
 
+// Decodes video frames ahead of time in a worker thread. The worker thread has an exclusive access to the video file
+// while a frame is being decoded, the main thread accesses the file only when no frame is being decoded.
+class SMKVideoSequence::FrameReader final : public MultiThreading::AsyncManager
+{
+public:
+    FrameReader( smk_t * videoFile, const unsigned long frameCount, const size_t frameSize )
+        : _videoFile( videoFile )
+        , _frameCount( frameCount )
+        , _frameSize( frameSize )
+    {
+        assert( _videoFile != nullptr );
+    }
+
+    void start()
+    {
+        createWorker();
+
+        const std::scoped_lock<std::mutex> lock( _mutex );
+
+        notifyWorker();
+    }
+
+    void reset()
+    {
+        std::unique_lock<std::mutex> lock( _mutex );
+
+        _frameNotification.wait( lock, [this] { return !_isDecoding; } );
+
+        smk_first( _videoFile );
+
+        _nextFrameId = 0;
+        _firstReadyFrame = 0;
+        _readyFrameCount = 0;
+
+        notifyWorker();
+    }
+
+    // Waits for the next frame to be decoded and swaps its content with the given containers.
+    void getNextFrame( std::vector<uint8_t> & data, std::vector<uint8_t> & palette )
+    {
+        std::unique_lock<std::mutex> lock( _mutex );
+
+        assert( _readyFrameCount > 0 || _nextFrameId < _frameCount );
+
+        _frameNotification.wait( lock, [this] { return _readyFrameCount > 0; } );
+
+        Frame & frame = _frames[_firstReadyFrame];
+        std::swap( data, frame.data );
+        std::swap( palette, frame.palette );
+
+        _firstReadyFrame = ( _firstReadyFrame + 1 ) % _frames.size();
+        --_readyFrameCount;
+
+        // The frame slot is free now, so the next frame can be decoded into it.
+        notifyWorker();
+    }
+
+    std::vector<uint8_t> getNextFramePalette()
+    {
+        std::unique_lock<std::mutex> lock( _mutex );
+
+        assert( _readyFrameCount > 0 || _nextFrameId < _frameCount );
+
+        _frameNotification.wait( lock, [this] { return _readyFrameCount > 0; } );
+
+        return _frames[_firstReadyFrame].palette;
+    }
+
+private:
+    struct Frame
+    {
+        std::vector<uint8_t> data;
+        std::vector<uint8_t> palette;
+    };
+
+    smk_t * const _videoFile;
+    const unsigned long _frameCount;
+    const size_t _frameSize;
+
+    // A ring buffer of decoded frames
+    std::array<Frame, 8> _frames;
+
+    std::condition_variable _frameNotification;
+
+    // These members are protected by _mutex
+    unsigned long _nextFrameId{ 0 };
+    size_t _firstReadyFrame{ 0 };
+    size_t _readyFrameCount{ 0 };
+    bool _isDecoding{ false };
+
+    // These members are accessed only by the worker thread
+    unsigned long _frameIdToDecode{ 0 };
+    size_t _frameToDecode{ 0 };
+
+    // This method is called by the worker thread and is protected by _mutex
+    bool prepareTask() override
+    {
+        if ( _readyFrameCount == _frames.size() || _nextFrameId >= _frameCount ) {
+            return false;
+        }
+
+        _frameIdToDecode = _nextFrameId;
+        _frameToDecode = ( _firstReadyFrame + _readyFrameCount ) % _frames.size();
+        _isDecoding = true;
+
+        return true;
+    }
+
+    // This method is called by the worker thread, but is not protected by _mutex
+    void executeTask() override
+    {
+        if ( !_isDecoding ) {
+            // Nothing to do.
+            return;
+        }
+
+        Frame & frame = _frames[_frameToDecode];
+
+        const uint8_t * data = smk_get_video( _videoFile );
+        const uint8_t * paletteData = smk_get_palette( _videoFile );
+        assert( data != nullptr && paletteData != nullptr );
+
+        frame.data.assign( data, data + _frameSize );
+        frame.palette.assign( paletteData, paletteData + 256 * 3 );
+
+        if ( _frameIdToDecode + 1 < _frameCount ) {
+            smk_next( _videoFile );
+        }
+
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _nextFrameId = _frameIdToDecode + 1;
+            ++_readyFrameCount;
+            _isDecoding = false;
+        }
+
+        _frameNotification.notify_all();
+    }
+};
+
 SMKVideoSequence::SMKVideoSequence( const std::string & filePath )
-    : _width( 0 )
+    : _filePath( filePath )
+    , _isAudioDecoded( false )
+    , _width( 0 )
     , _height( 0 )
     , _heightScaleFactor( 1 )
     , _fps( 0 )
@@ -77,14 +311,6 @@ SMKVideoSequence::SMKVideoSequence( const std::string & filePath )
 
     double usf = 0;
 
-    const uint8_t audioChannelCount = 7;
-
-    uint8_t trackMask = 0;
-    uint8_t channelsPerTrack[audioChannelCount] = { 0 };
-    uint8_t audioBitDepth[audioChannelCount] = { 0 };
-    unsigned long audioRate[audioChannelCount] = { 0 };
-    std::vector<std::vector<uint8_t>> soundBuffer( audioChannelCount );
-
     unsigned long width = 0;
     unsigned long height = 0;
     unsigned char scaledYMode = 1;
@@ -106,105 +332,28 @@ SMKVideoSequence::SMKVideoSequence( const std::string & filePath )
     _width = static_cast<int32_t>( width );
     _height = static_cast<int32_t>( height ) * _heightScaleFactor;
 
-    smk_info_audio( _videoFile, &trackMask, channelsPerTrack, audioBitDepth, audioRate );
-
     if ( usf > 0 )
         _fps = 1000000.0 / usf;
     else
         _fps = 15; // let's use as a default
 
-    for ( uint8_t i = 0; i < audioChannelCount; ++i ) {
-        if ( trackMask & ( 1 << i ) ) {
-            smk_enable_audio( _videoFile, i, 1 );
-        }
-    }
-
-    smk_enable_video( _videoFile, 0 ); // disable video reading
+    // Audio is decoded separately, only video is needed here.
+    smk_enable_all( _videoFile, 0 );
+    smk_enable_video( _videoFile, 1 );
     smk_first( _videoFile );
-    unsigned long currentFrame = 0;
-    smk_info_all( _videoFile, &currentFrame, nullptr, nullptr );
-
-    for ( uint8_t i = 0; i < audioChannelCount; ++i ) {
-        if ( trackMask & ( 1 << i ) ) {
-            const unsigned long length = smk_get_audio_size( _videoFile, i );
-            if ( length == 0 ) {
-                continue;
-            }
-
-            if ( soundBuffer[i].empty() ) {
-                soundBuffer[i].resize( audioHeaderSize );
-            }
-
-            const uint8_t * data = smk_get_audio( _videoFile, i );
-            soundBuffer[i].insert( soundBuffer[i].end(), data, data + length );
-        }
-    }
-
-    for ( currentFrame = 1; currentFrame < _frameCount; ++currentFrame ) {
-        smk_next( _videoFile );
 
-        for ( uint8_t i = 0; i < audioChannelCount; ++i ) {
-            if ( trackMask & ( 1 << i ) ) {
-                const unsigned long length = smk_get_audio_size( _videoFile, i );
-                if ( length == 0 ) {
-                    continue;
-                }
-
-                if ( soundBuffer[i].empty() ) {
-                    soundBuffer[i].resize( audioHeaderSize );
-                }
-
-                const uint8_t * data = smk_get_audio( _videoFile, i );
-                soundBuffer[i].insert( soundBuffer[i].end(), data, data + length );
-            }
-        }
+    if ( _frameCount > 0 ) {
+        _frameReader = std::make_unique<FrameReader>( _videoFile, _frameCount, static_cast<size_t>( width ) * height );
+        _frameReader->start();
     }
-
-    size_t channelCount = 0;
-    for ( size_t i = 0; i < soundBuffer.size(); ++i ) {
-        if ( !soundBuffer[i].empty() ) {
-            ++channelCount;
-        }
-    }
-    _audioChannel.resize( channelCount );
-
-    channelCount = 0;
-
-    // Compose the soundtrack
-    for ( size_t i = 0; i < soundBuffer.size(); ++i ) {
-        if ( !soundBuffer[i].empty() ) {
-            std::vector<uint8_t> & wavData = _audioChannel[channelCount];
-            std::swap( wavData, soundBuffer[i] );
-
-            const uint32_t originalSize = static_cast<uint32_t>( wavData.size() - audioHeaderSize );
-
-            ++channelCount;
-
-            RWStreamBuf wavHeader( audioHeaderSize );
-            wavHeader.putLE32( 0x46464952 ); // RIFF marker ("RIFF")
-            wavHeader.putLE32( originalSize + 0x24 ); // Total size minus the size of this and previous fields
-            wavHeader.putLE32( 0x45564157 ); // File type header ("WAVE")
-            wavHeader.putLE32( 0x20746D66 ); // Format sub-chunk marker ("fmt ")
-            wavHeader.putLE32( 0x10 ); // Size of the format sub-chunk
-            wavHeader.putLE16( 0x01 ); // Audio format (1 for PCM)
-            wavHeader.putLE16( channelsPerTrack[i] ); // Number of channels
-            wavHeader.putLE32( audioRate[i] ); // Sample rate
-            wavHeader.putLE32( audioRate[i] * audioBitDepth[i] * channelsPerTrack[i] / 8 ); // Byte rate
-            wavHeader.putLE16( audioBitDepth[i] * channelsPerTrack[i] / 8 ); // Block align
-            wavHeader.putLE16( audioBitDepth[i] ); // Bits per sample
-            wavHeader.putLE32( 0x61746164 ); // Data sub-chunk marker ("data")
-            wavHeader.putLE32( originalSize ); // Size of the data sub-chunk
-
-            memcpy( wavData.data(), wavHeader.data(), audioHeaderSize );
-        }
-    }
-
-    smk_enable_video( _videoFile, 1 ); // enable video reading
-    smk_first( _videoFile );
 }
 
 SMKVideoSequence::~SMKVideoSequence()
 {
+    if ( _frameReader ) {
+        _frameReader->stopWorker();
+    }
+
     if ( _videoFile != nullptr ) {
         smk_close( _videoFile );
     }
@@ -232,23 +381,27 @@ unsigned long SMKVideoSequence::frameCount() const
 
 void SMKVideoSequence::resetFrame()
 {
-    if ( _videoFile == nullptr )
+    if ( !_frameReader )
         return;
 
-    smk_first( _videoFile );
+    _frameReader->reset();
     _currentFrameId = 0;
 }
 
 void SMKVideoSequence::getNextFrame( fheroes2::Image & image, const int32_t x, const int32_t y, int32_t & width, int32_t & height, std::vector<uint8_t> & palette )
 {
-    if ( _videoFile == nullptr || image.empty() || x < 0 || y < 0 || x >= image.width() || y >= image.height() || !image.singleLayer() ) {
+    if ( !_frameReader || image.empty() || x < 0 || y < 0 || x >= image.width() || y >= image.height() || !image.singleLayer() ) {
         width = 0;
         height = 0;
         return;
     }
 
-    const uint8_t * data = smk_get_video( _videoFile );
-    const uint8_t * paletteData = smk_get_palette( _videoFile );
+    // The last frame is repeated once the end of the video is reached.
+    if ( _currentFrameId < _frameCount ) {
+        _frameReader->getNextFrame( _frameData, _framePalette );
+    }
+
+    const uint8_t * data = _frameData.data();
 
     width = _width;
     height = _height;
@@ -302,24 +455,28 @@ void SMKVideoSequence::getNextFrame( fheroes2::Image & image, const int32_t x, c
         }
     }
 
-    palette.resize( 256 * 3 );
-    memcpy( palette.data(), paletteData, 256 * 3 );
+    palette = _framePalette;
 
     ++_currentFrameId;
-    if ( _currentFrameId < _frameCount ) {
-        smk_next( _videoFile );
-    }
 }
 
-std::vector<uint8_t> SMKVideoSequence::getCurrentPalette() const
+std::vector<uint8_t> SMKVideoSequence::getCurrentPalette()
 {
-    const uint8_t * paletteData = smk_get_palette( _videoFile );
-    assert( paletteData != nullptr );
+    assert( _frameReader );
+
+    if ( _currentFrameId >= _frameCount ) {
+        return _framePalette;
+    }
 
-    return std::vector<uint8_t>( paletteData, paletteData + 256 * 3 );
+    return _frameReader->getNextFramePalette();
 }
 
-const std::vector<std::vector<uint8_t>> & SMKVideoSequence::getAudioChannels() const
+const std::vector<std::vector<uint8_t>> & SMKVideoSequence::getAudioChannels()
 {
+    if ( !_isAudioDecoded ) {
+        _isAudioDecoded = true;
+        _audioChannel = decodeAudioChannels( _filePath );
+    }
+
     return _audioChannel;
 }
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -29,6 +30,7 @@ namespace fheroes2
     class Image;
 }
 
+// Video frames are decoded in advance by a separate thread so the decoding time of a single frame does not affect the frame rate.
 class SMKVideoSequence
 {
 public:
@@ -44,9 +46,10 @@ public:
     // If the image is smaller than the frame then only a part of the frame will be drawn.
     void getNextFrame( fheroes2::Image & image, const int32_t x, const int32_t y, int32_t & width, int32_t & height, std::vector<uint8_t> & palette );
 
-    std::vector<uint8_t> getCurrentPalette() const;
+    std::vector<uint8_t> getCurrentPalette();
 
-    const std::vector<std::vector<uint8_t>> & getAudioChannels() const;
+    // Audio channels are decoded on the first call of this method.
+    const std::vector<std::vector<uint8_t>> & getAudioChannels();
 
     int32_t width() const;
     int32_t height() const;
@@ -59,7 +62,11 @@ public:
     }
 
 private:
+    class FrameReader;
+
+    std::string _filePath;
     std::vector<std::vector<uint8_t>> _audioChannel;
+    bool _isAudioDecoded;
     int32_t _width;
     int32_t _height;
     int32_t _heightScaleFactor;
@@ -67,5 +74,11 @@ private:
     unsigned long _frameCount;
     unsigned long _currentFrameId;
 
+    // The last frame received from the frame reader
+    std::vector<uint8_t> _frameData;
+    std::vector<uint8_t> _framePalette;
+
     struct smk_t * _videoFile;
+
+    std::unique_ptr<FrameReader> _frameReader;
 };
@@ -324,6 +324,16 @@ bool System::Unlink( const std::string_view path )
     return std::filesystem::remove( path, ec );
 }
 
+bool System::Rename( const std::string_view oldPath, const std::string_view newPath )
+{
+    std::error_code ec;
+
+    // Using the non-throwing overload
+    std::filesystem::rename( oldPath, newPath, ec );
+
+    return !ec;
+}
+
 std::string System::concatPath( const std::string_view left, const std::string_view right )
 {
     // Avoid memory allocation while concatenating string. Allocate needed size at once.
@@ -495,6 +505,27 @@ bool System::IsFile( const std::string_view path )
     return std::filesystem::is_regular_file( correctedPath, ec );
 }
 
+bool System::getFileSizeAndModificationTime( const std::string_view path, uint64_t & size, int64_t & modificationTime )
+{
+    std::error_code ec;
+
+    // Using the non-throwing overloads
+    const std::uintmax_t fileSize = std::filesystem::file_size( path, ec );
+    if ( ec ) {
+        return false;
+    }
+
+    const std::filesystem::file_time_type fileTime = std::filesystem::last_write_time( path, ec );
+    if ( ec ) {
+        return false;
+    }
+
+    size = static_cast<uint64_t>( fileSize );
+    modificationTime = static_cast<int64_t>( fileTime.time_since_epoch().count() );
+
+    return true;
+}
+
 bool System::IsDirectory( const std::string_view path )
 {
     if ( path.empty() ) {
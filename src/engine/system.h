@@ -24,6 +24,7 @@
 #ifndef H2SYSTEM_H
 #define H2SYSTEM_H
 
+#include <cstdint>
 #include <ctime>
 #include <string>
 #include <string_view>
@@ -42,6 +43,9 @@ namespace System
     bool MakeDirectory( const std::string_view path );
     bool Unlink( const std::string_view path );
 
+    // Renames the file or directory, replacing the destination file if it exists
+    bool Rename( const std::string_view oldPath, const std::string_view newPath );
+
     std::string concatPath( const std::string_view left, const std::string_view right );
 
     void appendOSSpecificDirectories( std::vector<std::string> & directories );
@@ -53,6 +57,10 @@ namespace System
     std::string GetStem( const std::string_view path );
 
     bool IsFile( const std::string_view path );
+
+    // Returns the size and the last modification time of the file. The modification time is only suitable for comparison with
+    // other values returned by this function on the same system. Returns false in case of error.
+    bool getFileSizeAndModificationTime( const std::string_view path, uint64_t & size, int64_t & modificationTime );
     bool IsDirectory( const std::string_view path );
 
     bool GetCaseInsensitivePath( const std::string_view path, std::string & correctedPath );
@@ -67,6 +67,18 @@ namespace fheroes2
         return passedMs >= delayMs;
     }
 
+    uint64_t TimeDelay::getRemainingMs() const
+    {
+        return getRemainingMs( _delayMs );
+    }
+
+    uint64_t TimeDelay::getRemainingMs( const uint64_t delayMs ) const
+    {
+        const auto time = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - _prevTime );
+        const uint64_t passedMs = time.count();
+        return passedMs >= delayMs ? 0 : delayMs - passedMs;
+    }
+
     void TimeDelay::reset()
     {
         _prevTime = std::chrono::steady_clock::now();
@@ -62,6 +62,10 @@ namespace fheroes2
         bool isPassed() const;
         bool isPassed( const uint64_t delayMs ) const;
 
+        // Returns the time in milliseconds left until the delay is passed, 0 if it has already been passed.
+        uint64_t getRemainingMs() const;
+        uint64_t getRemainingMs( const uint64_t delayMs ) const;
+
         // Reset delay by starting the count from the current time.
         void reset();
 
@@ -23,7 +23,10 @@
 
 #include "zzlib.h"
 
+#include <algorithm>
+#include <cassert>
 #include <cstring>
+#include <limits>
 #include <ostream>
 
 #include <zconf.h>
@@ -35,6 +38,9 @@
 namespace
 {
     constexpr uint16_t FORMAT_VERSION_0 = 0;
+
+    // Size of the buffers used by the streaming compression and decompression
+    constexpr size_t streamChunkSize = 64 * 1024;
 }
 
 namespace Compression
@@ -176,6 +182,415 @@ namespace Compression
         return !outputStream.fail();
     }
 
+    ZipFileOStream::ZipFileOStream( StreamFile & fileStream )
+        : _fileStream( fileStream )
+        , _zStream( std::make_unique<z_stream>() )
+        , _outputBuf( streamChunkSize )
+    {
+        setBigendian( IS_BIGENDIAN );
+
+        _inputBuf.reserve( streamChunkSize );
+
+        const int ret = deflateInit( _zStream.get(), Z_DEFAULT_COMPRESSION );
+        if ( ret != Z_OK ) {
+            ERROR_LOG( "zlib error: " << ret )
+
+            _zStream.reset();
+            setFail( true );
+
+            return;
+        }
+
+        // The actual sizes will be written when the stream is finalized
+        _headerPos = _fileStream.tell();
+
+        _fileStream.put32( 0 );
+        _fileStream.put32( 0 );
+        _fileStream.put16( FORMAT_VERSION_0 );
+        _fileStream.put16( 0 ); // Unused bytes
+
+        if ( _fileStream.fail() ) {
+            setFail( true );
+        }
+    }
+
+    ZipFileOStream::~ZipFileOStream()
+    {
+        if ( _zStream ) {
+            deflateEnd( _zStream.get() );
+        }
+    }
+
+    void ZipFileOStream::putBE16( uint16_t v )
+    {
+        put8( v >> 8 );
+        put8( v & 0xFF );
+    }
+
+    void ZipFileOStream::putLE16( uint16_t v )
+    {
+        put8( v & 0xFF );
+        put8( v >> 8 );
+    }
+
+    void ZipFileOStream::putBE32( uint32_t v )
+    {
+        put8( v >> 24 );
+        put8( ( v >> 16 ) & 0xFF );
+        put8( ( v >> 8 ) & 0xFF );
+        put8( v & 0xFF );
+    }
+
+    void ZipFileOStream::putLE32( uint32_t v )
+    {
+        put8( v & 0xFF );
+        put8( ( v >> 8 ) & 0xFF );
+        put8( ( v >> 16 ) & 0xFF );
+        put8( v >> 24 );
+    }
+
+    void ZipFileOStream::putRaw( const void * ptr, size_t sz )
+    {
+        const uint8_t * data = static_cast<const uint8_t *>( ptr );
+
+        while ( sz > 0 && !fail() ) {
+            const size_t count = std::min( sz, streamChunkSize - _inputBuf.size() );
+
+            _inputBuf.insert( _inputBuf.end(), data, data + count );
+
+            data += count;
+            sz -= count;
+
+            if ( _inputBuf.size() == streamChunkSize ) {
+                deflateInput( Z_NO_FLUSH );
+            }
+        }
+    }
+
+    bool ZipFileOStream::finalize()
+    {
+        assert( !_isFinalized );
+
+        _isFinalized = true;
+
+        if ( fail() || !deflateInput( Z_FINISH ) ) {
+            return false;
+        }
+
+        const size_t endPos = _fileStream.tell();
+
+        _fileStream.seek( _headerPos );
+        _fileStream.put32( _rawSize );
+        _fileStream.put32( _zipSize );
+        _fileStream.seek( endPos );
+
+        if ( _fileStream.fail() ) {
+            setFail( true );
+            return false;
+        }
+
+        return true;
+    }
+
+    void ZipFileOStream::put8( const uint8_t v )
+    {
+        if ( fail() ) {
+            return;
+        }
+
+        assert( !_isFinalized );
+
+        _inputBuf.push_back( v );
+
+        if ( _inputBuf.size() == streamChunkSize ) {
+            deflateInput( Z_NO_FLUSH );
+        }
+    }
+
+    size_t ZipFileOStream::sizep()
+    {
+        return streamChunkSize - _inputBuf.size();
+    }
+
+    size_t ZipFileOStream::tellp()
+    {
+        return static_cast<size_t>( _rawSize ) + _inputBuf.size();
+    }
+
+    bool ZipFileOStream::deflateInput( const int flush )
+    {
+        if ( !_zStream ) {
+            setFail( true );
+            return false;
+        }
+
+        if ( _inputBuf.size() > std::numeric_limits<uint32_t>::max() - _rawSize ) {
+            ERROR_LOG( "The size of the source data is too large" )
+
+            setFail( true );
+            return false;
+        }
+
+        _zStream->next_in = _inputBuf.data();
+        _zStream->avail_in = static_cast<uInt>( _inputBuf.size() );
+
+        int ret = Z_OK;
+
+        do {
+            _zStream->next_out = _outputBuf.data();
+            _zStream->avail_out = static_cast<uInt>( _outputBuf.size() );
+
+            ret = deflate( _zStream.get(), flush );
+            if ( ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR ) {
+                ERROR_LOG( "zlib error: " << ret )
+
+                setFail( true );
+                return false;
+            }
+
+            const size_t outputSize = _outputBuf.size() - _zStream->avail_out;
+            if ( outputSize > std::numeric_limits<uint32_t>::max() - _zipSize ) {
+                ERROR_LOG( "The size of the compressed data is too large" )
+
+                setFail( true );
+                return false;
+            }
+
+            _fileStream.putRaw( _outputBuf.data(), outputSize );
+            if ( _fileStream.fail() ) {
+                setFail( true );
+                return false;
+            }
+
+            _zipSize += static_cast<uint32_t>( outputSize );
+        } while ( flush == Z_FINISH ? ret != Z_STREAM_END : _zStream->avail_out == 0 );
+
+        assert( _zStream->avail_in == 0 );
+
+        _rawSize += static_cast<uint32_t>( _inputBuf.size() );
+        _inputBuf.clear();
+
+        return true;
+    }
+
+    UnzipIStream::UnzipIStream( IStreamBase & inputStream )
+        : _inputStream( inputStream )
+        , _zStream( std::make_unique<z_stream>() )
+        , _outputBuf( streamChunkSize )
+    {
+        setBigendian( IS_BIGENDIAN );
+
+        _rawSize = _inputStream.get32();
+        _zipSize = _inputStream.get32();
+        _zipSizeLeft = _zipSize;
+
+        const uint16_t version = _inputStream.get16();
+
+        _inputStream.skip( 2 ); // Unused bytes
+
+        if ( _inputStream.fail() || _zipSize == 0 || version != FORMAT_VERSION_0 ) {
+            _zStream.reset();
+            setFail( true );
+
+            return;
+        }
+
+        const int ret = inflateInit( _zStream.get() );
+        if ( ret != Z_OK ) {
+            ERROR_LOG( "zlib error: " << ret )
+
+            _zStream.reset();
+            setFail( true );
+        }
+    }
+
+    UnzipIStream::~UnzipIStream()
+    {
+        if ( _zStream ) {
+            inflateEnd( _zStream.get() );
+        }
+    }
+
+    void UnzipIStream::skip( size_t sz )
+    {
+        read( nullptr, sz );
+    }
+
+    uint16_t UnzipIStream::getBE16()
+    {
+        uint16_t result = ( static_cast<uint16_t>( get8() ) << 8 );
+
+        result |= get8();
+
+        return result;
+    }
+
+    uint16_t UnzipIStream::getLE16()
+    {
+        uint16_t result = get8();
+
+        result |= ( static_cast<uint16_t>( get8() ) << 8 );
+
+        return result;
+    }
+
+    uint32_t UnzipIStream::getBE32()
+    {
+        uint32_t result = ( static_cast<uint32_t>( get8() ) << 24 );
+
+        result |= ( static_cast<uint32_t>( get8() ) << 16 );
+        result |= ( static_cast<uint32_t>( get8() ) << 8 );
+        result |= get8();
+
+        return result;
+    }
+
+    uint32_t UnzipIStream::getLE32()
+    {
+        uint32_t result = get8();
+
+        result |= ( static_cast<uint32_t>( get8() ) << 8 );
+        result |= ( static_cast<uint32_t>( get8() ) << 16 );
+        result |= ( static_cast<uint32_t>( get8() ) << 24 );
+
+        return result;
+    }
+
+    std::vector<uint8_t> UnzipIStream::getRaw( size_t sz /* = 0 */ )
+    {
+        const size_t resultSize = sz > 0 ? sz : sizeg();
+
+        std::vector<uint8_t> result( resultSize, 0 );
+
+        readRaw( result.data(), resultSize );
+
+        return result;
+    }
+
+    uint8_t UnzipIStream::get8()
+    {
+        if ( _outputPos < _outputEnd ) {
+            ++_rawSizeRead;
+
+            return _outputBuf[_outputPos++];
+        }
+
+        uint8_t result = 0;
+
+        if ( read( &result, 1 ) != 1 ) {
+            setFail( true );
+        }
+
+        return result;
+    }
+
+    void UnzipIStream::readRaw( void * ptr, const size_t size )
+    {
+        uint8_t * dst = static_cast<uint8_t *>( ptr );
+
+        const size_t sizeRead = read( dst, size );
+        if ( sizeRead < size ) {
+            std::fill( dst + sizeRead, dst + size, static_cast<uint8_t>( 0 ) );
+
+            setFail( true );
+        }
+    }
+
+    size_t UnzipIStream::sizeg()
+    {
+        return _rawSize > _rawSizeRead ? _rawSize - _rawSizeRead : 0;
+    }
+
+    size_t UnzipIStream::tellg()
+    {
+        return _rawSizeRead;
+    }
+
+    bool UnzipIStream::inflateOutput()
+    {
+        if ( !_zStream || _isStreamEnd ) {
+            return false;
+        }
+
+        _zStream->next_out = _outputBuf.data();
+        _zStream->avail_out = static_cast<uInt>( _outputBuf.size() );
+
+        _outputPos = 0;
+        _outputEnd = 0;
+
+        // Keep feeding the compressed data until at least some decompressed data is produced
+        while ( _zStream->avail_out == _outputBuf.size() ) {
+            if ( _zStream->avail_in == 0 ) {
+                if ( _zipSizeLeft == 0 ) {
+                    ERROR_LOG( "Unexpected end of the compressed data" )
+
+                    setFail( true );
+                    return false;
+                }
+
+                _inputBuf = _inputStream.getRaw( std::min<size_t>( streamChunkSize, _zipSizeLeft ) );
+                if ( _inputStream.fail() || _inputBuf.empty() ) {
+                    setFail( true );
+                    return false;
+                }
+
+                _zipSizeLeft -= static_cast<uint32_t>( _inputBuf.size() );
+
+                _zStream->next_in = _inputBuf.data();
+                _zStream->avail_in = static_cast<uInt>( _inputBuf.size() );
+            }
+
+            const int ret = inflate( _zStream.get(), Z_NO_FLUSH );
+            if ( ret == Z_STREAM_END ) {
+                _isStreamEnd = true;
+
+                if ( _zStream->total_out != _rawSize ) {
+                    ERROR_LOG( "The size of the decompressed data does not match the expected size" )
+
+                    setFail( true );
+                    return false;
+                }
+
+                break;
+            }
+
+            if ( ret != Z_OK ) {
+                ERROR_LOG( "zlib error: " << ret )
+
+                setFail( true );
+                return false;
+            }
+        }
+
+        _outputEnd = _outputBuf.size() - _zStream->avail_out;
+
+        return _outputEnd > 0;
+    }
+
+    size_t UnzipIStream::read( uint8_t * dst, size_t sz )
+    {
+        size_t copied = 0;
+
+        while ( copied < sz ) {
+            if ( _outputPos == _outputEnd && !inflateOutput() ) {
+                break;
+            }
+
+            const size_t count = std::min( sz - copied, _outputEnd - _outputPos );
+
+            if ( dst != nullptr ) {
+                std::copy_n( _outputBuf.data() + _outputPos, count, dst + copied );
+            }
+
+            _outputPos += count;
+            copied += count;
+        }
+
+        _rawSizeRead += static_cast<uint32_t>( copied );
+
+        return copied;
+    }
+
     fheroes2::Image CreateImageFromZlib( int32_t width, int32_t height, const uint8_t * imageData, size_t imageSize, bool doubleLayer )
     {
         if ( imageData == nullptr || imageSize == 0 || width <= 0 || height <= 0 ) {
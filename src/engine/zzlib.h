@@ -26,13 +26,13 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "image.h"
+#include "serialize.h"
 
-class IStreamBase;
-class OStreamBase;
-class IStreamBuf;
+struct z_stream_s;
 
 namespace Compression
 {
@@ -54,6 +54,127 @@ namespace Compression
     // true on success and false on error.
     bool zipStreamBuf( IStreamBuf & inputStream, OStreamBase & outputStream );
 
+    // Output stream that compresses the data written to it on the fly and writes it to the given file as a zipped chunk
+    // in the same format as zipStreamBuf() does. Only fixed-size buffers are used regardless of the amount of data. The
+    // sizes in the chunk header are written by the finalize() method, so the chunk is valid only after a successful call
+    // to this method.
+    class ZipFileOStream final : public OStreamBase
+    {
+    public:
+        explicit ZipFileOStream( StreamFile & fileStream );
+        ZipFileOStream( const ZipFileOStream & ) = delete;
+
+        ~ZipFileOStream() override;
+
+        ZipFileOStream & operator=( const ZipFileOStream & ) = delete;
+
+        void putBE16( uint16_t v ) override;
+        void putLE16( uint16_t v ) override;
+        void putBE32( uint32_t v ) override;
+        void putLE32( uint32_t v ) override;
+
+        void putRaw( const void * ptr, size_t sz ) override;
+
+        // Flushes all the remaining data to the file and updates the chunk header. Returns true on success and false on
+        // error. No data can be written to this stream after this call.
+        bool finalize();
+
+        uint32_t rawSize() const
+        {
+            return _rawSize;
+        }
+
+        uint32_t zipSize() const
+        {
+            return _zipSize;
+        }
+
+    private:
+        void put8( const uint8_t v ) override;
+
+        size_t sizep() override;
+        size_t tellp() override;
+
+        // Compresses the contents of the input buffer and writes the compressed data to the file
+        bool deflateInput( const int flush );
+
+        StreamFile & _fileStream;
+        std::unique_ptr<z_stream_s> _zStream;
+
+        std::vector<uint8_t> _inputBuf;
+        std::vector<uint8_t> _outputBuf;
+
+        size_t _headerPos{ 0 };
+        uint32_t _rawSize{ 0 };
+        uint32_t _zipSize{ 0 };
+
+        bool _isFinalized{ false };
+    };
+
+    // Input stream that reads the zipped chunk from the given input stream and decompresses it on demand while the data
+    // is being read. Only fixed-size buffers are used regardless of the amount of data. If the chunk header is invalid,
+    // the stream is marked as failed right after its creation.
+    class UnzipIStream final : public IStreamBase
+    {
+    public:
+        explicit UnzipIStream( IStreamBase & inputStream );
+        UnzipIStream( const UnzipIStream & ) = delete;
+
+        ~UnzipIStream() override;
+
+        UnzipIStream & operator=( const UnzipIStream & ) = delete;
+
+        void skip( size_t sz ) override;
+
+        uint16_t getBE16() override;
+        uint16_t getLE16() override;
+        uint32_t getBE32() override;
+        uint32_t getLE32() override;
+
+        // 0 stands for all data.
+        std::vector<uint8_t> getRaw( size_t sz = 0 ) override;
+
+        uint32_t rawSize() const
+        {
+            return _rawSize;
+        }
+
+        uint32_t zipSize() const
+        {
+            return _zipSize;
+        }
+
+    private:
+        uint8_t get8() override;
+
+        void readRaw( void * ptr, const size_t size ) override;
+
+        size_t sizeg() override;
+        size_t tellg() override;
+
+        // Decompresses the next portion of data into the output buffer. Returns false if there is no more data or on error.
+        bool inflateOutput();
+
+        // Copies up to 'sz' bytes of the decompressed data to 'dst' (if it is not null) and returns the number of bytes copied
+        size_t read( uint8_t * dst, size_t sz );
+
+        IStreamBase & _inputStream;
+        std::unique_ptr<z_stream_s> _zStream;
+
+        std::vector<uint8_t> _inputBuf;
+        std::vector<uint8_t> _outputBuf;
+
+        size_t _outputPos{ 0 };
+        size_t _outputEnd{ 0 };
+
+        uint32_t _rawSize{ 0 };
+        uint32_t _zipSize{ 0 };
+        uint32_t _zipSizeLeft{ 0 };
+        uint32_t _rawSizeRead{ 0 };
+
+        bool _isStreamEnd{ false };
+    };
+
     fheroes2::Image CreateImageFromZlib( int32_t width, int32_t height, const uint8_t * imageData, size_t imageSize, bool doubleLayer );
 }
 
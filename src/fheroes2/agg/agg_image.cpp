@@ -28,6 +28,7 @@
 #include <initializer_list>
 #include <map>
 #include <numeric>
+#include <ostream>
 #include <random>
 #include <set>
 #include <stdexcept>
@@ -44,11 +45,14 @@
 #include "icn.h"
 #include "image.h"
 #include "image_tool.h"
+#include "logging.h"
 #include "math_base.h"
 #include "pal.h"
 #include "rand.h"
 #include "screen.h"
 #include "serialize.h"
+#include "settings.h"
+#include "system.h"
 #include "til.h"
 #include "tools.h"
 #include "translations.h"
@@ -57,6 +61,7 @@
 #include "ui_language.h"
 #include "ui_text.h"
 #include "ui_tool.h"
+#include "zzlib.h"
 
 namespace
 {
@@ -379,6 +384,251 @@ namespace
 
     OriginalAlphabetPreserver alphabetPreserver;
 
+    // Increased every time font glyphs are regenerated.
+    uint32_t fontGeneration{ 0 };
+
+    // Some fonts are generated by a time-consuming code, so they are stored on the disk and loaded from there on subsequent launches.
+    // Every cache file contains a key calculated from the source data used for generation, so a file created for a different set of
+    // resources or a different language is never used.
+    const uint32_t icnCacheFileMagic{ 0x46483249 }; // "FH2I"
+    // Should be increased every time the output of any cached font generation code changes.
+    const uint16_t icnCacheFileVersion{ 1 };
+
+    // Fonts which are generated from the normal font.
+    const std::array<int, 5> cachedDerivedFontIcnIds{ ICN::WHITE_LARGE_FONT, ICN::GOLDEN_GRADIENT_FONT, ICN::GOLDEN_GRADIENT_LARGE_FONT, ICN::SILVER_GRADIENT_FONT,
+                                                      ICN::SILVER_GRADIENT_LARGE_FONT };
+
+    const std::array<int, 4> buttonFontIcnIds{ ICN::BUTTON_GOOD_FONT_RELEASED, ICN::BUTTON_GOOD_FONT_PRESSED, ICN::BUTTON_EVIL_FONT_RELEASED,
+                                               ICN::BUTTON_EVIL_FONT_PRESSED };
+
+    const std::array<int, 2> alphabetIcnIds{ ICN::FONT, ICN::SMALFONT };
+
+    bool isCachedDerivedFontIcnId( const int id )
+    {
+        return std::find( cachedDerivedFontIcnIds.begin(), cachedDerivedFontIcnIds.end(), id ) != cachedDerivedFontIcnIds.end();
+    }
+
+    std::string getIcnCacheDirectory()
+    {
+        return System::concatPath( System::concatPath( System::concatPath( System::GetDataDirectory( "fheroes2" ), "files" ), "cache" ), "icn" );
+    }
+
+    void writeSprites( OStreamBase & stream, const std::vector<fheroes2::Sprite> & sprites )
+    {
+        stream.put32( static_cast<uint32_t>( sprites.size() ) );
+
+        for ( const fheroes2::Sprite & sprite : sprites ) {
+            stream << sprite.width() << sprite.height() << sprite.x() << sprite.y() << sprite.singleLayer();
+
+            if ( !sprite.empty() ) {
+                // Both layers are stored one after another.
+                stream.putRaw( sprite.image(), static_cast<size_t>( sprite.width() ) * sprite.height() * 2 );
+            }
+        }
+    }
+
+    bool readSprites( IStreamBase & stream, std::vector<fheroes2::Sprite> & sprites )
+    {
+        const uint32_t spriteCount = stream.get32();
+
+        sprites.clear();
+
+        for ( uint32_t i = 0; i < spriteCount; ++i ) {
+            int32_t width = 0;
+            int32_t height = 0;
+            int32_t offsetX = 0;
+            int32_t offsetY = 0;
+            bool isSingleLayer = false;
+
+            stream >> width >> height >> offsetX >> offsetY >> isSingleLayer;
+
+            if ( stream.fail() || width < 0 || height < 0 ) {
+                return false;
+            }
+
+            fheroes2::Sprite sprite;
+            sprite.setPosition( offsetX, offsetY );
+
+            if ( width > 0 && height > 0 ) {
+                const size_t size = static_cast<size_t>( width ) * height * 2;
+
+                const std::vector<uint8_t> data = stream.getRaw( size );
+                if ( data.size() != size ) {
+                    return false;
+                }
+
+                sprite.resize( width, height );
+                std::copy( data.begin(), data.end(), sprite.image() );
+            }
+
+            if ( isSingleLayer ) {
+                sprite._disableTransformLayer();
+            }
+
+            sprites.emplace_back( std::move( sprite ) );
+        }
+
+        return !stream.fail();
+    }
+
+    uint32_t calculateSpritesChecksum( const std::initializer_list<int> icnIds, const std::string & extraData )
+    {
+        RWStreamBuf stream;
+        stream.setBigendian( true );
+
+        stream << extraData;
+
+        for ( const int id : icnIds ) {
+            writeSprites( stream, _icnVsSprite[id] );
+        }
+
+        return fheroes2::calculateCRC32( stream.data(), stream.size() );
+    }
+
+    template <size_t Count>
+    bool loadIcnsFromCache( const std::string & name, const uint32_t key, const std::array<int, Count> & icnIds )
+    {
+        const std::string filePath = System::concatPath( getIcnCacheDirectory(), name + ".cache" );
+
+        StreamFile fileStream;
+        fileStream.setBigendian( true );
+
+        if ( !System::IsFile( filePath ) || !fileStream.open( filePath, "rb" ) ) {
+            return false;
+        }
+
+        uint32_t magic = 0;
+        uint16_t version = 0;
+        std::string gameVersion;
+        uint32_t fileKey = 0;
+
+        fileStream >> magic >> version >> gameVersion >> fileKey;
+
+        if ( fileStream.fail() || magic != icnCacheFileMagic || version != icnCacheFileVersion || gameVersion != Settings::GetVersion() || fileKey != key ) {
+            // The file has been created for other resources or by another version of the game. It will be overwritten.
+            return false;
+        }
+
+        Compression::UnzipIStream zipStream( fileStream );
+        zipStream.setBigendian( true );
+
+        std::array<std::vector<fheroes2::Sprite>, Count> icns;
+
+        for ( std::vector<fheroes2::Sprite> & sprites : icns ) {
+            if ( !readSprites( zipStream, sprites ) || sprites.empty() ) {
+                DEBUG_LOG( DBG_GAME, DBG_WARN, "Cached ICN file " << filePath << " is corrupted." )
+                return false;
+            }
+        }
+
+        for ( size_t i = 0; i < Count; ++i ) {
+            _icnVsSprite[icnIds[i]] = std::move( icns[i] );
+        }
+
+        return true;
+    }
+
+    template <size_t Count>
+    void saveIcnsToCache( const std::string & name, const uint32_t key, const std::array<int, Count> & icnIds )
+    {
+        const std::string cacheDirectory = getIcnCacheDirectory();
+        if ( !System::IsDirectory( cacheDirectory ) && !System::MakeDirectory( cacheDirectory ) ) {
+            ERROR_LOG( "Unable to create a directory " << cacheDirectory )
+            return;
+        }
+
+        const std::string filePath = System::concatPath( cacheDirectory, name + ".cache" );
+        const std::string tempFilePath = filePath + ".tmp";
+
+        bool isWritten = false;
+
+        {
+            StreamFile fileStream;
+            fileStream.setBigendian( true );
+
+            if ( fileStream.open( tempFilePath, "wb" ) ) {
+                fileStream << icnCacheFileMagic << icnCacheFileVersion << Settings::GetVersion() << key;
+
+                Compression::ZipFileOStream zipStream( fileStream );
+                zipStream.setBigendian( true );
+
+                for ( const int id : icnIds ) {
+                    writeSprites( zipStream, _icnVsSprite[id] );
+                }
+
+                isWritten = !fileStream.fail() && zipStream.finalize();
+            }
+        }
+
+        if ( !isWritten || !System::Rename( tempFilePath, filePath ) ) {
+            ERROR_LOG( "Unable to write a cached ICN file " << filePath )
+
+            System::Unlink( tempFilePath );
+        }
+    }
+
+    // Returns the key of cache files for fonts generated from the normal font. The key is calculated only once per set of font glyphs.
+    uint32_t getDerivedFontCacheKey()
+    {
+        static bool isCalculated{ false };
+        static uint32_t keyFontGeneration{ 0 };
+        static uint32_t key{ 0 };
+
+        if ( !isCalculated || keyFontGeneration != fontGeneration ) {
+            fheroes2::AGG::GetICN( ICN::FONT, 0 );
+
+            key = calculateSpritesChecksum( { ICN::FONT }, {} );
+            keyFontGeneration = fontGeneration;
+            isCalculated = true;
+        }
+
+        return key;
+    }
+
+    std::string getDerivedFontCacheName( const int id )
+    {
+        return "font_" + std::to_string( id );
+    }
+
+    void loadAlphabet( const fheroes2::SupportedLanguage language )
+    {
+        // The generated alphabet depends on the original glyphs loaded from AGG files which must be restored at this point.
+        const std::string languageAbbreviation = fheroes2::getLanguageAbbreviation( language );
+        const uint32_t key = calculateSpritesChecksum( { ICN::FONT, ICN::SMALFONT }, languageAbbreviation );
+        const std::string cacheName = "alphabet_" + languageAbbreviation;
+
+        if ( loadIcnsFromCache( cacheName, key, alphabetIcnIds ) ) {
+            // Fonts based on the previous alphabet are no longer valid.
+            for ( const int id : { ICN::YELLOW_FONT, ICN::YELLOW_SMALLFONT, ICN::GRAY_FONT, ICN::GRAY_SMALL_FONT } ) {
+                _icnVsSprite[id].clear();
+            }
+
+            for ( const int id : cachedDerivedFontIcnIds ) {
+                _icnVsSprite[id].clear();
+            }
+
+            return;
+        }
+
+        fheroes2::generateAlphabet( language, _icnVsSprite );
+
+        saveIcnsToCache( cacheName, key, alphabetIcnIds );
+    }
+
+    void loadButtonAlphabet( const fheroes2::SupportedLanguage language )
+    {
+        // Button fonts are generated from scratch so they depend only on the language.
+        const std::string cacheName = std::string( "button_font_" ) + fheroes2::getLanguageAbbreviation( language );
+
+        if ( loadIcnsFromCache( cacheName, 0, buttonFontIcnIds ) ) {
+            return;
+        }
+
+        fheroes2::generateButtonAlphabet( language, _icnVsSprite );
+
+        saveIcnsToCache( cacheName, 0, buttonFontIcnIds );
+    }
+
     // This class is used for situations when we need to remove letter-specific offsets, like when we display single letters in a row,
     // and then restore these offsets within the scope of the code
     class ButtonFontOffsetRestorer
@@ -4602,8 +4852,14 @@ namespace
         case ICN::BUTTON_GOOD_FONT_PRESSED:
         case ICN::BUTTON_EVIL_FONT_RELEASED:
         case ICN::BUTTON_EVIL_FONT_PRESSED: {
+            if ( loadIcnsFromCache( "button_font_base", 0, buttonFontIcnIds ) ) {
+                return true;
+            }
+
             generateBaseButtonFont( _icnVsSprite[ICN::BUTTON_GOOD_FONT_RELEASED], _icnVsSprite[ICN::BUTTON_GOOD_FONT_PRESSED],
                                     _icnVsSprite[ICN::BUTTON_EVIL_FONT_RELEASED], _icnVsSprite[ICN::BUTTON_EVIL_FONT_PRESSED] );
+
+            saveIcnsToCache( "button_font_base", 0, buttonFontIcnIds );
             return true;
         }
         case ICN::HISCORE: {
@@ -5033,7 +5289,21 @@ namespace
             return;
         }
 
-        if ( !LoadModifiedICN( id ) ) {
+        if ( isCachedDerivedFontIcnId( id ) ) {
+            const std::array<int, 1> icnIds{ id };
+            const uint32_t key = getDerivedFontCacheKey();
+
+            if ( loadIcnsFromCache( getDerivedFontCacheName( id ), key, icnIds ) ) {
+                return;
+            }
+
+            LoadModifiedICN( id );
+
+            if ( !_icnVsSprite[id].empty() ) {
+                saveIcnsToCache( getDerivedFontCacheName( id ), key, icnIds );
+            }
+        }
+        else if ( !LoadModifiedICN( id ) ) {
             LoadOriginalICN( id );
         }
 
@@ -5223,6 +5493,11 @@ namespace fheroes2::AGG
         return height;
     }
 
+    uint32_t getFontGeneration()
+    {
+        return fontGeneration;
+    }
+
     uint32_t getCharacterLimit( const FontSize fontSize )
     {
         switch ( fontSize ) {
@@ -5344,13 +5619,15 @@ namespace fheroes2::AGG
             alphabetPreserver.preserve();
             // Restore original letters when changing language to avoid changes to them being carried over.
             alphabetPreserver.restore();
-            generateAlphabet( language, _icnVsSprite );
+            loadAlphabet( language );
         }
-        generateButtonAlphabet( language, _icnVsSprite );
+        loadButtonAlphabet( language );
 
         // Clear language dependent resources.
         for ( const int id : languageDependentIcnId ) {
             _icnVsSprite[id].clear();
         }
+
+        ++fontGeneration;
     }
 }
@@ -42,6 +42,9 @@ namespace fheroes2
 
         int32_t GetAbsoluteICNHeight( int icnId );
 
+        // Returns a number which is changed every time font glyphs are regenerated, for example when a new language is set.
+        uint32_t getFontGeneration();
+
         uint32_t getCharacterLimit( const FontSize fontSize );
         const Sprite & getChar( const uint8_t character, const FontType & fontType );
 
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <array>
+#include <bitset>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
@@ -46,6 +47,7 @@
 #include "battle_board.h"
 #include "battle_cell.h"
 #include "battle_command.h"
+#include "battle_pathfinding.h"
 #include "battle_tower.h"
 #include "battle_troop.h"
 #include "castle.h"
@@ -268,32 +270,6 @@ namespace
         return result;
     }
 
-    bool isUnitAbleToApproachPosition( const Battle::Unit * unit, const Battle::Position & pos )
-    {
-        assert( unit != nullptr );
-
-        // Also consider the next turn, even if this unit has already acted during the current turn
-        const uint32_t speed = unit->GetSpeed( false, true );
-
-        // Immovable unit is not taken into account, even if it is already near the given position
-        if ( speed == Speed::STANDING ) {
-            return false;
-        }
-
-        for ( const int32_t nearbyIdx : Battle::Board::GetAroundIndexes( pos ) ) {
-            const Battle::Position nearbyPos = Battle::Position::GetReachable( *unit, nearbyIdx, speed );
-            if ( nearbyPos.GetHead() == nullptr ) {
-                continue;
-            }
-
-            assert( nearbyPos.isValidForUnit( unit ) );
-
-            return true;
-        }
-
-        return false;
-    }
-
     MeleeAttackOutcome BestAttackOutcome( const Battle::Unit & attacker, const Battle::Unit & defender, const PositionValues & valuesOfAttackPositions,
                                           const std::function<bool( const Battle::Position & )> & posFilter = {} )
     {
@@ -375,10 +351,6 @@ namespace
 
                 assert( arena.isPositionReachable( currentUnit, stepPos, true ) );
 
-#ifdef NDEBUG
-                (void)arena;
-#endif
-
                 pathStepsThreatLevels.emplace_back( stepPos, 0.0 );
             }
         }
@@ -391,8 +363,10 @@ namespace
                 continue;
             }
 
+            const std::bitset<ARENASIZE> & enemyReachableCells = arena.getNextTurnReachableCells( *enemy );
+
             for ( auto & [stepPos, stepThreatLevel] : pathStepsThreatLevels ) {
-                if ( !isUnitAbleToApproachPosition( enemy, stepPos ) ) {
+                if ( !Battle::BattleThreatMap::isPositionApproachable( enemyReachableCells, stepPos ) ) {
                     continue;
                 }
 
@@ -1182,7 +1156,7 @@ Battle::Actions AI::BattlePlanner::archerDecision( Battle::Arena & arena, const
             uint32_t distanceToNearestEnemy{ UINT32_MAX };
         };
 
-        const auto evaluatePotentialPositions = [&currentUnit, &enemies]( std::map<Battle::Position, PositionCharacteristics> & potentialPositions ) {
+        const auto evaluatePotentialPositions = [&arena, &currentUnit, &enemies]( std::map<Battle::Position, PositionCharacteristics> & potentialPositions ) {
             class UnitRemover
             {
             public:
@@ -1253,22 +1227,27 @@ Battle::Actions AI::BattlePlanner::archerDecision( Battle::Arena & arena, const
             for ( const Battle::Unit * enemy : enemies ) {
                 assert( enemy != nullptr );
 
+                // Archers who not blocked by enemy units generally threaten any position, but for the purpose
+                // of this assessment, it is assumed that they threaten only in melee, that is, in positions
+                // directly adjacent to them
+                const bool isEnemyThreatensOnlyAdjacentPositions = enemy->isArchers() && !enemy->isHandFighting();
+
+                // The potential event of enemy's good morale is not taken into account here
+                const std::bitset<ARENASIZE> enemyReachableCells
+                    = isEnemyThreatensOnlyAdjacentPositions ? std::bitset<ARENASIZE>{} : arena.getNextTurnReachableCells( *enemy );
+
                 for ( auto & [position, characteristics] : potentialPositions ) {
                     assert( position.GetHead() != nullptr );
 
-                    const bool isPositionUnderEnemyThreat = [enemy]( const Battle::Position & pos ) {
-                        // Archers who not blocked by enemy units generally threaten any position, but for the purpose
-                        // of this assessment, it is assumed that they threaten only in melee, that is, in positions
-                        // directly adjacent to them
-                        if ( enemy->isArchers() && !enemy->isHandFighting() ) {
+                    const bool isPositionUnderEnemyThreat = [enemy, isEnemyThreatensOnlyAdjacentPositions, &enemyReachableCells]( const Battle::Position & pos ) {
+                        if ( isEnemyThreatensOnlyAdjacentPositions ) {
                             const uint32_t distanceToEnemy = Battle::Board::GetDistance( pos, enemy->GetPosition() );
                             assert( distanceToEnemy > 0 );
 
                             return ( distanceToEnemy == 1 );
                         }
 
-                        // The potential event of enemy's good morale is not taken into account here
-                        return isUnitAbleToApproachPosition( enemy, pos );
+                        return Battle::BattleThreatMap::isPositionApproachable( enemyReachableCells, pos );
                     }( position );
 
                     if ( isPositionUnderEnemyThreat ) {
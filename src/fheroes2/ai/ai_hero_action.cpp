@@ -1757,6 +1757,8 @@ namespace
                     artifact = Artifact::UNKNOWN;
                 }
             }
+
+            Army::invalidateStrengthCache();
         }
 
         DEBUG_LOG( DBG_AI, DBG_INFO, hero.GetName() << " removed " << cursed << " artifacts" )
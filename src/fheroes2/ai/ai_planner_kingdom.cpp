@@ -750,6 +750,9 @@ void AI::Planner::KingdomTurn( Kingdom & kingdom )
 
     AudioManager::PlayMusicAsync( MUS::COMPUTER_TURN, Music::PlaybackMode::RESUME_AND_PLAY_INFINITE );
 
+    // Strength of the same armies is evaluated many times during the AI turn, cache it
+    const Army::StrengthCacheScope armyStrengthCacheScope;
+
     VecHeroes & heroes = kingdom.GetHeroes();
     const VecCastles & castles = kingdom.GetCastles();
 
@@ -953,6 +956,11 @@ void AI::Planner::KingdomTurn( Kingdom & kingdom )
     }
 
     status.DrawAITurnProgress( 10 );
+
+    DEBUG_LOG( DBG_AI, DBG_INFO,
+               Color::String( myColor ) << " army strength cache hits: " << armyStrengthCacheScope.getHitCount()
+                                        << ", misses: " << armyStrengthCacheScope.getMissCount() << ", troop strength cache hits: "
+                                        << armyStrengthCacheScope.getTroopHitCount() << ", misses: " << armyStrengthCacheScope.getTroopMissCount() )
 }
 
 bool AI::Planner::purchaseNewHeroes( const std::vector<AICastle> & sortedCastleList, const std::set<int> & castlesInDanger, const int32_t availableHeroCount,
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <functional>
 #include <map>
 #include <numeric>
 #include <random>
@@ -69,6 +70,12 @@ namespace fheroes2
 
 namespace
 {
+    // Army strength cache is enabled only while an instance of Army::StrengthCacheScope exists
+    bool isStrengthCacheEnabled{ false };
+    uint32_t strengthCacheVersion{ 0 };
+    uint32_t strengthCacheHitCount{ 0 };
+    uint32_t strengthCacheMissCount{ 0 };
+
     enum class ArmySize : uint32_t
     {
         ARMY_FEW = 1,
@@ -224,17 +231,60 @@ Troops::Troops( const Troops & troops )
     for ( const Troop * troop : troops ) {
         assert( troop != nullptr );
 
-        push_back( new Troop( *troop ) );
+        push_back( createTroop( *troop ) );
     }
 }
 
 Troops::~Troops()
 {
-    std::for_each( begin(), end(), []( Troop * troop ) {
-        assert( troop != nullptr );
+    std::for_each( begin(), end(), [this]( Troop * troop ) { destroyTroop( troop ); } );
+}
 
-        delete troop;
-    } );
+Troop * Troops::createTroop( const Troop & troop )
+{
+    for ( size_t i = 0; i < _inlineTroops.size(); ++i ) {
+        if ( _inlineTroopsInUse.test( i ) ) {
+            continue;
+        }
+
+        _inlineTroopsInUse.set( i );
+        static_cast<Troop &>( _inlineTroops[i] ) = troop;
+
+        return &_inlineTroops[i];
+    }
+
+    return new Troop( troop );
+}
+
+ArmyTroop * Troops::createArmyTroop( const Army & army )
+{
+    for ( size_t i = 0; i < _inlineTroops.size(); ++i ) {
+        if ( _inlineTroopsInUse.test( i ) ) {
+            continue;
+        }
+
+        _inlineTroopsInUse.set( i );
+        _inlineTroops[i].SetArmy( army );
+
+        return &_inlineTroops[i];
+    }
+
+    return nullptr;
+}
+
+void Troops::destroyTroop( Troop * troop )
+{
+    assert( troop != nullptr );
+
+    for ( size_t i = 0; i < _inlineTroops.size(); ++i ) {
+        if ( troop == &_inlineTroops[i] ) {
+            _inlineTroopsInUse.reset( i );
+
+            return;
+        }
+    }
+
+    delete troop;
 }
 
 void Troops::Assign( const Troop * itbeg, const Troop * itend )
@@ -271,12 +321,12 @@ void Troops::Assign( const Troops & troops )
 void Troops::Insert( const Troops & troops )
 {
     for ( const_iterator it = troops.begin(); it != troops.end(); ++it )
-        push_back( new Troop( **it ) );
+        push_back( createTroop( **it ) );
 }
 
 void Troops::PushBack( const Monster & mons, uint32_t count )
 {
-    push_back( new Troop( mons, count ) );
+    push_back( createTroop( Troop( mons, count ) ) );
 }
 
 void Troops::PopBack()
@@ -285,7 +335,7 @@ void Troops::PopBack()
         return;
     }
 
-    delete back();
+    destroyTroop( back() );
 
     pop_back();
 }
@@ -644,7 +694,7 @@ Troops Troops::GetOptimized() const
             = std::find_if( result.begin(), result.end(), [monsterId]( const Troop * resultTroop ) { return resultTroop->isMonster( monsterId ); } );
 
         if ( iter == result.end() ) {
-            result.push_back( new Troop( *troop ) );
+            result.push_back( result.createTroop( *troop ) );
         }
         else {
             Troop * resultTroop = *iter;
@@ -986,7 +1036,10 @@ Army::Army( HeroBase * cmdr /* = nullptr */ )
     reserve( maximumTroopCount );
 
     for ( size_t i = 0; i < maximumTroopCount; ++i ) {
-        push_back( new ArmyTroop( this ) );
+        ArmyTroop * troop = createArmyTroop( *this );
+        assert( troop != nullptr );
+
+        push_back( troop );
     }
 }
 
@@ -998,7 +1051,10 @@ Army::Army( const Maps::Tiles & tile )
     reserve( maximumTroopCount );
 
     for ( size_t i = 0; i < maximumTroopCount; ++i ) {
-        push_back( new ArmyTroop( this ) );
+        ArmyTroop * troop = createArmyTroop( *this );
+        assert( troop != nullptr );
+
+        push_back( troop );
     }
 
     setFromTile( tile );
@@ -1265,7 +1321,81 @@ int Army::GetMoraleModificator( std::string * strs ) const
     return result;
 }
 
+Army::StrengthCacheScope::StrengthCacheScope()
+{
+    assert( !isStrengthCacheEnabled );
+
+    isStrengthCacheEnabled = true;
+    strengthCacheHitCount = 0;
+    strengthCacheMissCount = 0;
+
+    invalidateStrengthCache();
+}
+
+Army::StrengthCacheScope::~StrengthCacheScope()
+{
+    assert( isStrengthCacheEnabled );
+
+    isStrengthCacheEnabled = false;
+}
+
+uint32_t Army::StrengthCacheScope::getHitCount() const
+{
+    return strengthCacheHitCount;
+}
+
+uint32_t Army::StrengthCacheScope::getMissCount() const
+{
+    return strengthCacheMissCount;
+}
+
+void Army::invalidateStrengthCache()
+{
+    ++strengthCacheVersion;
+
+    // Zero version is reserved for invalid cache entries
+    if ( strengthCacheVersion == 0 ) {
+        ++strengthCacheVersion;
+    }
+}
+
 double Army::GetStrength() const
+{
+    if ( !isStrengthCacheEnabled ) {
+        return calculateStrength();
+    }
+
+    StrengthCache cache;
+    cache.version = strengthCacheVersion;
+    cache.color = color;
+    cache.commander = commander;
+    cache.commanderSpellPoints = ( commander != nullptr ) ? commander->GetSpellPoints() : 0;
+
+    assert( size() == cache.troops.size() );
+
+    for ( size_t i = 0; i < size(); ++i ) {
+        const Troop * troop = at( i );
+        assert( troop != nullptr );
+
+        cache.troops[i] = { troop->GetID(), troop->GetCount() };
+    }
+
+    if ( cache.version == _strengthCache.version && cache.color == _strengthCache.color && cache.commander == _strengthCache.commander
+         && cache.commanderSpellPoints == _strengthCache.commanderSpellPoints && cache.troops == _strengthCache.troops ) {
+        ++strengthCacheHitCount;
+
+        return _strengthCache.strength;
+    }
+
+    ++strengthCacheMissCount;
+
+    cache.strength = calculateStrength();
+    _strengthCache = cache;
+
+    return cache.strength;
+}
+
+double Army::calculateStrength() const
 {
     double result = 0;
 
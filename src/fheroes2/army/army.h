@@ -24,12 +24,16 @@
 #ifndef H2ARMY_H
 #define H2ARMY_H
 
+#include <array>
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "army_troop.h"
 #include "monster.h"
 #include "players.h"
 
@@ -39,7 +43,6 @@ class OStreamBase;
 class Castle;
 class HeroBase;
 class Heroes;
-class Troop;
 
 namespace Maps
 {
@@ -124,6 +127,9 @@ public:
     void MergeSameMonsterTroops();
 
 protected:
+    // The number of troops that can be stored inline without heap allocations
+    static const size_t inlineTroopCapacity = 5;
+
     void JoinStrongest( Troops & giverArmy, const bool keepAtLeastOneSlotForGiver );
 
     // Combines two stacks consisting of identical monsters. Returns true if there was something to combine, otherwise returns false.
@@ -131,9 +137,22 @@ protected:
     // Returns an optimized version of this Troops instance, i.e. all stacks of identical monsters are combined and there are no empty slots
     Troops GetOptimized() const;
 
+    // Takes a free slot of the inline storage and binds it to the given army. Returns nullptr if there are no free slots.
+    ArmyTroop * createArmyTroop( const Army & army );
+
 private:
     // Returns the stack that best matches the specified condition or nullptr if there are no valid stacks
     Troop * getBestMatchToCondition( const std::function<bool( const Troop *, const Troop * )> & condition ) const;
+
+    // Creates a copy of the given troop owned by this instance. The first troops are placed in the inline storage, the rest are allocated on the heap.
+    Troop * createTroop( const Troop & troop );
+    void destroyTroop( Troop * troop );
+
+    // Most instances (copies of armies, lists of reinforcements, etc) contain no more than a few troops, so they are stored inline to avoid a separate
+    // heap allocation for each of them. The pointers to these troops remain valid during the lifetime of this instance. An Army keeps its own troops
+    // in this storage as well, which is why they are of the ArmyTroop type. Troops of other instances are not bound to any army.
+    std::array<ArmyTroop, inlineTroopCapacity> _inlineTroops;
+    std::bitset<inlineTroopCapacity> _inlineTroopsInUse;
 };
 
 struct NeutralMonsterJoiningCondition
@@ -174,6 +193,41 @@ public:
 
     static NeutralMonsterJoiningCondition GetJoinSolution( const Heroes &, const Maps::Tiles &, const Troop & );
 
+    // Evaluation of the army strength is quite expensive. While an instance of this class exists, the strength of each army is cached and is
+    // re-evaluated only if its troops, color, commander or commander's spell points have changed, or if the strength cache version has been
+    // bumped since the last evaluation. The strength of individual troops is cached as well.
+    class StrengthCacheScope
+    {
+    public:
+        StrengthCacheScope();
+        StrengthCacheScope( const StrengthCacheScope & ) = delete;
+
+        ~StrengthCacheScope();
+
+        StrengthCacheScope & operator=( const StrengthCacheScope & ) = delete;
+
+        uint32_t getHitCount() const;
+        uint32_t getMissCount() const;
+
+        uint32_t getTroopHitCount() const
+        {
+            return _troopStrengthCacheScope.getHitCount();
+        }
+
+        uint32_t getTroopMissCount() const
+        {
+            return _troopStrengthCacheScope.getMissCount();
+        }
+
+    private:
+        Troop::StrengthCacheScope _troopStrengthCacheScope;
+    };
+
+    // Bumps the version of the strength cache, so that the strength of every army will be re-evaluated. This method should be called by every
+    // mutator that can affect the strength of armies in a way that is not tracked by the cache itself (e.g. changes of the skills, level or
+    // artifacts of heroes, changes of castle buildings or of the position of heroes relative to castles).
+    static void invalidateStrengthCache();
+
     static void drawSingleDetailedMonsterLine( const Troops & troops, int32_t cx, int32_t cy, int32_t width );
     static void drawMultipleMonsterLines( const Troops & troops, int32_t posX, int32_t posY, int32_t lineWidth, bool isCompact, const bool isDetailedView,
                                           const bool isGarrisonView = false, const uint32_t thievesGuildsCount = 0 );
@@ -222,6 +276,9 @@ public:
     void SetCommander( HeroBase * c )
     {
         commander = c;
+
+        // The commander determines the castle the army is in, so the cached strength of this army can no longer be used
+        _strengthCache.version = 0;
     }
 
     const Castle * inCastle() const;
@@ -266,9 +323,29 @@ private:
     // the tile index) with a random chance to get an upgraded stack of monsters in the center (if allowed)
     void ArrangeForBattle( const Monster & monster, const uint32_t monstersCount, const int32_t tileIndex, const bool allowUpgrade );
 
+    static_assert( inlineTroopCapacity >= maximumTroopCount, "Troops of the army should fit into the inline storage" );
+
+    struct StrengthCache
+    {
+        // Version of the strength cache at the time of evaluation, zero means that the cached value is invalid
+        uint32_t version{ 0 };
+
+        int color{ 0 };
+        const HeroBase * commander{ nullptr };
+        uint32_t commanderSpellPoints{ 0 };
+        // Monster ID and count for each troop
+        std::array<std::pair<int, uint32_t>, maximumTroopCount> troops{};
+
+        double strength{ 0 };
+    };
+
+    double calculateStrength() const;
+
     HeroBase * commander;
     bool _isSpreadCombatFormation;
     int color;
+
+    mutable StrengthCache _strengthCache;
 };
 
 #endif
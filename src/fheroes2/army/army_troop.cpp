@@ -23,6 +23,9 @@
 
 #include "army_troop.h"
 
+#include <array>
+#include <cassert>
+
 #include "army.h"
 #include "color.h"
 #include "heroes_base.h"
@@ -30,6 +33,23 @@
 #include "serialize.h"
 #include "speed.h"
 
+namespace
+{
+    struct MonsterStrengthCacheEntry
+    {
+        int attack{ 0 };
+        int defense{ 0 };
+        // Negative value means that the cache entry is invalid
+        double strength{ -1 };
+    };
+
+    // Monster strength cache is enabled only while an instance of Troop::StrengthCacheScope exists
+    bool isMonsterStrengthCacheEnabled{ false };
+    std::array<MonsterStrengthCacheEntry, Monster::MONSTER_COUNT> monsterStrengthCache;
+    uint32_t monsterStrengthCacheHitCount{ 0 };
+    uint32_t monsterStrengthCacheMissCount{ 0 };
+}
+
 Troop::Troop()
     : Monster( Monster::UNKNOWN )
     , count( 0 )
@@ -114,7 +134,56 @@ double Troop::GetStrength() const
 
 double Troop::GetStrengthWithBonus( int bonusAttack, int bonusDefense ) const
 {
-    return Monster::GetMonsterStrength( Monster::GetAttack() + bonusAttack, Monster::GetDefense() + bonusDefense ) * count;
+    const int attack = static_cast<int>( Monster::GetAttack() ) + bonusAttack;
+    const int defense = static_cast<int>( Monster::GetDefense() ) + bonusDefense;
+
+    if ( !isMonsterStrengthCacheEnabled || id < 0 || id >= Monster::MONSTER_COUNT ) {
+        return Monster::GetMonsterStrength( attack, defense ) * count;
+    }
+
+    MonsterStrengthCacheEntry & entry = monsterStrengthCache[id];
+
+    if ( entry.strength >= 0 && entry.attack == attack && entry.defense == defense ) {
+        ++monsterStrengthCacheHitCount;
+
+        return entry.strength * count;
+    }
+
+    ++monsterStrengthCacheMissCount;
+
+    entry.attack = attack;
+    entry.defense = defense;
+    entry.strength = Monster::GetMonsterStrength( attack, defense );
+
+    return entry.strength * count;
+}
+
+Troop::StrengthCacheScope::StrengthCacheScope()
+{
+    assert( !isMonsterStrengthCacheEnabled );
+
+    isMonsterStrengthCacheEnabled = true;
+    monsterStrengthCacheHitCount = 0;
+    monsterStrengthCacheMissCount = 0;
+
+    monsterStrengthCache.fill( {} );
+}
+
+Troop::StrengthCacheScope::~StrengthCacheScope()
+{
+    assert( isMonsterStrengthCacheEnabled );
+
+    isMonsterStrengthCacheEnabled = false;
+}
+
+uint32_t Troop::StrengthCacheScope::getHitCount() const
+{
+    return monsterStrengthCacheHitCount;
+}
+
+uint32_t Troop::StrengthCacheScope::getMissCount() const
+{
+    return monsterStrengthCacheMissCount;
 }
 
 bool Troop::isValid() const
@@ -80,6 +80,22 @@ public:
     double GetStrength() const;
     double GetStrengthWithBonus( int bonusAttack, int bonusDefense ) const;
 
+    // While an instance of this class exists, the strength of a single monster with the given attack and defense values is cached for each
+    // monster type, so that GetStrengthWithBonus() doesn't have to re-evaluate it for every troop.
+    class StrengthCacheScope
+    {
+    public:
+        StrengthCacheScope();
+        StrengthCacheScope( const StrengthCacheScope & ) = delete;
+
+        ~StrengthCacheScope();
+
+        StrengthCacheScope & operator=( const StrengthCacheScope & ) = delete;
+
+        uint32_t getHitCount() const;
+        uint32_t getMissCount() const;
+    };
+
 protected:
     friend OStreamBase & operator<<( OStreamBase & stream, const Troop & troop );
     friend IStreamBase & operator>>( IStreamBase & stream, Troop & troop );
@@ -92,6 +108,8 @@ protected:
 class ArmyTroop : public Troop
 {
 public:
+    // A troop that is not bound to any army behaves exactly like Troop
+    ArmyTroop() = default;
     explicit ArmyTroop( const Army * );
     ArmyTroop( const Army *, const Troop & );
 
@@ -111,7 +129,7 @@ public:
     std::string GetDefenseString() const override;
 
 protected:
-    const Army * army;
+    const Army * army{ nullptr };
 };
 
 #endif
@@ -28,10 +28,13 @@
 #include <cstddef>
 #include <cstdlib>
 #include <deque>
+#include <iomanip>
 #include <list>
+#include <map>
 #include <mutex>
 #include <optional>
 #include <ostream>
+#include <sstream>
 #include <utility>
 
 #include "agg_file.h"
@@ -218,43 +221,215 @@ namespace
         }
     }
 
+    // Converted MIDI tracks are stored on the disk so the conversion of every XMI track has to be done only once.
+    // Every file is named after the checksum and the size of the source XMI data, so a track from a different AGG file
+    // never picks up a stale conversion result.
+    const uint32_t midCacheFileMagic{ 0x4D494443 }; // "MIDC"
+    // Should be increased every time the output of the XMI to MIDI converter changes.
+    const uint16_t midCacheFileVersion{ 1 };
+
+    std::string getMidCacheDirectory()
+    {
+        return System::concatPath( System::concatPath( System::concatPath( System::GetDataDirectory( "fheroes2" ), "files" ), "cache" ), "music" );
+    }
+
+    std::string getMidCacheFilePath( const std::vector<uint8_t> & xmiData )
+    {
+        std::ostringstream os;
+        os << std::hex << std::setfill( '0' ) << std::setw( 8 ) << fheroes2::calculateCRC32( xmiData.data(), xmiData.size() ) << '_' << std::dec
+           << xmiData.size() << ".mid";
+
+        return System::concatPath( getMidCacheDirectory(), os.str() );
+    }
+
+    bool readMidFromCache( const std::string & filePath, std::vector<uint8_t> & v )
+    {
+        StreamFile fileStream;
+        fileStream.setBigendian( true );
+
+        if ( !System::IsFile( filePath ) || !fileStream.open( filePath, "rb" ) ) {
+            return false;
+        }
+
+        if ( fileStream.get32() != midCacheFileMagic || fileStream.get16() != midCacheFileVersion ) {
+            return false;
+        }
+
+        const uint32_t checksum = fileStream.get32();
+        std::vector<uint8_t> data = fileStream.getRaw();
+
+        if ( fileStream.fail() || data.empty() || fheroes2::calculateCRC32( data.data(), data.size() ) != checksum ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "Cached MIDI file " << filePath << " is corrupted." )
+            return false;
+        }
+
+        v = std::move( data );
+
+        return true;
+    }
+
+    void writeMidToCache( const std::string & filePath, const std::vector<uint8_t> & v )
+    {
+        const std::string cacheDirectory = getMidCacheDirectory();
+        if ( !System::IsDirectory( cacheDirectory ) && !System::MakeDirectory( cacheDirectory ) ) {
+            ERROR_LOG( "Unable to create a directory " << cacheDirectory )
+            return;
+        }
+
+        const std::string tempFilePath = filePath + ".tmp";
+
+        bool isWritten = false;
+
+        {
+            StreamFile fileStream;
+            fileStream.setBigendian( true );
+
+            if ( fileStream.open( tempFilePath, "wb" ) ) {
+                fileStream << midCacheFileMagic << midCacheFileVersion << fheroes2::calculateCRC32( v.data(), v.size() );
+                fileStream.putRaw( v.data(), v.size() );
+
+                isWritten = !fileStream.fail();
+            }
+        }
+
+        if ( !isWritten || !System::Rename( tempFilePath, filePath ) ) {
+            ERROR_LOG( "Unable to write a cached MIDI file " << filePath )
+
+            System::Unlink( tempFilePath );
+        }
+    }
+
     void LoadMID( int xmi, std::vector<uint8_t> & v )
     {
         DEBUG_LOG( DBG_GAME, DBG_TRACE, XMI::GetString( xmi ) )
         const std::vector<uint8_t> & body = getDataFromAggFile( XMI::GetString( xmi ), xmi >= XMI::MIDI_ORIGINAL_KNIGHT );
 
-        if ( !body.empty() ) {
-            v = Music::Xmi2Mid( body );
+        if ( body.empty() ) {
+            return;
+        }
+
+        const std::string cacheFilePath = getMidCacheFilePath( body );
+        if ( readMidFromCache( cacheFilePath, v ) ) {
+            return;
+        }
+
+        v = Music::Xmi2Mid( body );
+
+        if ( !v.empty() ) {
+            writeMidToCache( cacheFilePath, v );
         }
     }
 
-    std::map<int, std::vector<uint8_t>> wavDataCache;
-    std::map<int, std::vector<uint8_t>> MIDDataCache;
+    // In-memory cache of decoded audio data limited by the total size of the stored data. The least recently used entries are evicted
+    // first. References returned by the cache remain valid until a new entry is added or the cache is cleared.
+    class AudioDataCache
+    {
+    public:
+        explicit AudioDataCache( const size_t maxSize )
+            : _maxSize( maxSize )
+        {
+            // Do nothing.
+        }
+
+        AudioDataCache( const AudioDataCache & ) = delete;
+
+        ~AudioDataCache() = default;
+
+        AudioDataCache & operator=( const AudioDataCache & ) = delete;
+
+        const std::vector<uint8_t> * find( const int id )
+        {
+            auto iter = _index.find( id );
+            if ( iter == _index.end() ) {
+                return nullptr;
+            }
+
+            // Mark the entry as the most recently used one.
+            _entries.splice( _entries.begin(), _entries, iter->second );
+
+            return &iter->second->second;
+        }
+
+        const std::vector<uint8_t> & add( const int id, std::vector<uint8_t> && data )
+        {
+            assert( _index.find( id ) == _index.end() );
+
+            _size += data.size();
+
+            _entries.emplace_front( id, std::move( data ) );
+            _index.emplace( id, _entries.begin() );
+
+            // The newly added entry is always kept, even if it alone exceeds the limit.
+            while ( _size > _maxSize && _entries.size() > 1 ) {
+                const auto & [entryId, entryData] = _entries.back();
+
+                _size -= entryData.size();
+                _index.erase( entryId );
+                _entries.pop_back();
+            }
+
+            return _entries.front().second;
+        }
+
+        void clear()
+        {
+            _entries.clear();
+            _index.clear();
+            _size = 0;
+        }
+
+    private:
+        const size_t _maxSize;
+        size_t _size{ 0 };
+
+        std::list<std::pair<int, std::vector<uint8_t>>> _entries;
+        std::map<int, std::list<std::pair<int, std::vector<uint8_t>>>::iterator> _index;
+    };
+
+    // Mixer and Music make their own copies of the data, so these caches only save the time needed to read and convert it again.
+    AudioDataCache wavDataCache( 16 * 1024 * 1024 );
+    AudioDataCache MIDDataCache( 2 * 1024 * 1024 );
 
     const std::vector<uint8_t> & GetWAV( int m82 )
     {
-        std::vector<uint8_t> & v = wavDataCache[m82];
+        const std::vector<uint8_t> * cached = wavDataCache.find( m82 );
+        if ( cached != nullptr ) {
+            return *cached;
+        }
+
+        std::vector<uint8_t> v;
+        LoadWAV( m82, v );
+
         if ( v.empty() ) {
-            LoadWAV( m82, v );
+            static const std::vector<uint8_t> empty;
+            return empty;
         }
 
-        return v;
+        return wavDataCache.add( m82, std::move( v ) );
     }
 
     const std::vector<uint8_t> & GetMID( int xmi )
     {
-        std::vector<uint8_t> & v = MIDDataCache[xmi];
+        const std::vector<uint8_t> * cached = MIDDataCache.find( xmi );
+        if ( cached != nullptr ) {
+            return *cached;
+        }
+
+        std::vector<uint8_t> v;
+        LoadMID( xmi, v );
+
         if ( v.empty() ) {
-            LoadMID( xmi, v );
+            static const std::vector<uint8_t> empty;
+            return empty;
         }
 
-        return v;
+        return MIDDataCache.add( xmi, std::move( v ) );
     }
 
     // Returns the ID of the channel occupied by the sound being played, or a negative value (-1) in case of failure.
     int PlaySoundImpl( const int m82 );
     void PlayMusicImpl( const int trackId, const MusicSource musicType, const Music::PlaybackMode playbackMode );
-    void playLoopSoundsImpl( std::map<M82::SoundType, std::vector<AudioManager::AudioLoopEffectInfo>> soundEffects, const bool is3DAudioEnabled );
+    void playLoopSoundsImpl( std::vector<AudioManager::AudioLoopEffectInfo> soundEffects, const bool is3DAudioEnabled );
 
     // SDL MIDI player is a single threaded library which requires a lot of time to start playing some long midi compositions.
     // This leads to a situation of a short application freeze while a hero crosses terrains or ending a battle.
@@ -279,17 +454,23 @@ namespace
 
             const std::scoped_lock<std::mutex> lock( _mutex );
 
+            // The same sound requested again before the previous request was processed would just be played twice at the same time.
+            if ( std::any_of( _soundTasks.begin(), _soundTasks.end(), [m82Sound]( const SoundTask & task ) { return task.m82Sound == m82Sound; } ) ) {
+                return;
+            }
+
             _soundTasks.emplace_back( m82Sound );
 
             notifyWorker();
         }
 
-        void pushLoopSound( std::map<M82::SoundType, std::vector<AudioManager::AudioLoopEffectInfo>> effects, const bool is3DAudioEnabled )
+        void pushLoopSound( std::vector<AudioManager::AudioLoopEffectInfo> effects, const bool is3DAudioEnabled )
         {
             createWorker();
 
             const std::scoped_lock<std::mutex> lock( _mutex );
 
+            // Every loop sound task describes the full state of loop sounds, so a pending task is always superseded by the new one.
             _loopSoundTask.emplace( std::move( effects ), is3DAudioEnabled );
 
             notifyWorker();
@@ -394,14 +575,14 @@ namespace
         {
             LoopSoundTask() = default;
 
-            LoopSoundTask( std::map<M82::SoundType, std::vector<AudioManager::AudioLoopEffectInfo>> effects, const bool is3DAudioOn )
+            LoopSoundTask( std::vector<AudioManager::AudioLoopEffectInfo> effects, const bool is3DAudioOn )
                 : soundEffects( std::move( effects ) )
                 , is3DAudioEnabled( is3DAudioOn )
             {
                 // Do nothing.
             }
 
-            std::map<M82::SoundType, std::vector<AudioManager::AudioLoopEffectInfo>> soundEffects;
+            std::vector<AudioManager::AudioLoopEffectInfo> soundEffects;
             bool is3DAudioEnabled{ false };
         };
 
@@ -481,7 +662,8 @@ namespace
         }
     };
 
-    std::map<M82::SoundType, std::vector<ChannelAudioLoopEffectInfo>> currentAudioLoopEffects;
+    // Sorted in the same order as the sound effects passed to playLoopSoundsImpl()
+    std::vector<ChannelAudioLoopEffectInfo> currentAudioLoopEffects;
     bool is3DAudioLoopEffectsEnabled{ false };
 
     // The music track last requested to be played
@@ -626,21 +808,19 @@ namespace
 
     void clearAllAudioLoopEffects()
     {
-        for ( const auto & audioEffectPair : currentAudioLoopEffects ) {
-            const std::vector<ChannelAudioLoopEffectInfo> & existingEffects = audioEffectPair.second;
-
-            for ( const ChannelAudioLoopEffectInfo & info : existingEffects ) {
-                if ( Mixer::isPlaying( info.channelId ) ) {
-                    Mixer::Stop( info.channelId );
-                }
+        for ( const ChannelAudioLoopEffectInfo & info : currentAudioLoopEffects ) {
+            if ( Mixer::isPlaying( info.channelId ) ) {
+                Mixer::Stop( info.channelId );
             }
         }
 
         currentAudioLoopEffects.clear();
     }
 
-    void playLoopSoundsImpl( std::map<M82::SoundType, std::vector<AudioManager::AudioLoopEffectInfo>> soundEffects, const bool is3DAudioEnabled )
+    void playLoopSoundsImpl( std::vector<AudioManager::AudioLoopEffectInfo> soundEffects, const bool is3DAudioEnabled )
     {
+        assert( std::is_sorted( soundEffects.begin(), soundEffects.end() ) );
+
         const std::scoped_lock<std::recursive_mutex> lock( g_asyncSoundManager.resourceMutex() );
 
         if ( is3DAudioLoopEffectsEnabled != is3DAudioEnabled ) {
@@ -648,62 +828,80 @@ namespace
             clearAllAudioLoopEffects();
         }
 
-        // TODO: use another container for sound effects to support more efficient sort and find operations based on the code below.
+        // Remove all sounds which aren't currently played anymore. This might be the case when Audio::Stop() function is called.
+        currentAudioLoopEffects.erase( std::remove_if( currentAudioLoopEffects.begin(), currentAudioLoopEffects.end(),
+                                                       []( const ChannelAudioLoopEffectInfo & info ) { return !Mixer::isPlaying( info.channelId ); } ),
+                                       currentAudioLoopEffects.end() );
 
-        std::map<M82::SoundType, std::vector<ChannelAudioLoopEffectInfo>> tempAudioLoopEffects;
-        std::swap( tempAudioLoopEffects, currentAudioLoopEffects );
+        if ( std::equal( currentAudioLoopEffects.begin(), currentAudioLoopEffects.end(), soundEffects.begin(), soundEffects.end() ) ) {
+            // Nothing has changed since the previous update.
+            return;
+        }
 
-        // Remove all sounds which aren't currently played anymore. This might be the case when Audio::Stop() function is called.
-        for ( auto iter = tempAudioLoopEffects.begin(); iter != tempAudioLoopEffects.end(); ) {
-            std::vector<ChannelAudioLoopEffectInfo> & existingEffects = iter->second;
+        std::vector<ChannelAudioLoopEffectInfo> previousAudioLoopEffects;
+        std::swap( previousAudioLoopEffects, currentAudioLoopEffects );
 
-            for ( auto effectIter = existingEffects.begin(); effectIter != existingEffects.end(); ) {
-                if ( !Mixer::isPlaying( effectIter->channelId ) ) {
-                    effectIter = existingEffects.erase( effectIter );
-                }
-                else {
-                    ++effectIter;
-                }
-            }
+        currentAudioLoopEffects.reserve( soundEffects.size() );
+
+        // Both containers are sorted, so sounds which have the exact type, distance and angle can be found in a single pass.
+        // These sounds are kept as is, the rest of them are either moved to new positions or replaced.
+        std::vector<AudioManager::AudioLoopEffectInfo> effectsToAdd;
+        std::vector<ChannelAudioLoopEffectInfo> effectsToReplace;
 
-            if ( existingEffects.empty() ) {
-                iter = tempAudioLoopEffects.erase( iter );
+        auto previousIter = previousAudioLoopEffects.cbegin();
+
+        for ( const AudioManager::AudioLoopEffectInfo & info : soundEffects ) {
+            while ( previousIter != previousAudioLoopEffects.cend() && *previousIter < info ) {
+                effectsToReplace.emplace_back( *previousIter );
+                ++previousIter;
             }
-            else {
-                ++iter;
+
+            if ( previousIter != previousAudioLoopEffects.cend() && *previousIter == info ) {
+                currentAudioLoopEffects.emplace_back( *previousIter );
+                ++previousIter;
+                continue;
             }
+
+            effectsToAdd.emplace_back( info );
         }
 
-        // First find channels with existing sounds and just update them.
-        for ( auto iter = soundEffects.begin(); iter != soundEffects.end(); ) {
-            const M82::SoundType soundType = iter->first;
-            std::vector<AudioManager::AudioLoopEffectInfo> & effectsToAdd = iter->second;
-            assert( !effectsToAdd.empty() );
+        effectsToReplace.insert( effectsToReplace.end(), previousIter, previousAudioLoopEffects.cend() );
 
-            auto foundSoundTypeIter = tempAudioLoopEffects.find( soundType );
-            if ( foundSoundTypeIter == tempAudioLoopEffects.end() ) {
-                // This sound type does not exist.
-                ++iter;
-                continue;
-            }
+        // Move the existing sounds of the same type to the positions of the new ones with the closest angles.
+        std::vector<AudioManager::AudioLoopEffectInfo> soundTypeEffectsToAdd;
+        std::vector<ChannelAudioLoopEffectInfo> soundTypeEffectsToReplace;
 
-            std::vector<ChannelAudioLoopEffectInfo> & effectsToReplace = foundSoundTypeIter->second;
+        std::vector<AudioManager::AudioLoopEffectInfo> effectsToPlay;
+        std::vector<ChannelAudioLoopEffectInfo> effectsToStop;
 
-            // Search for an existing sound which has the exact distance and angle.
-            for ( auto soundToAddIter = effectsToAdd.begin(); soundToAddIter != effectsToAdd.end(); ) {
-                auto exactSoundEffect = std::find( effectsToReplace.begin(), effectsToReplace.end(), *soundToAddIter );
-                if ( exactSoundEffect != effectsToReplace.end() ) {
-                    currentAudioLoopEffects[soundType].emplace_back( *exactSoundEffect );
-                    effectsToReplace.erase( exactSoundEffect );
+        auto addIter = effectsToAdd.cbegin();
+        auto replaceIter = effectsToReplace.cbegin();
 
-                    soundToAddIter = effectsToAdd.erase( soundToAddIter );
-                    continue;
+        while ( addIter != effectsToAdd.cend() || replaceIter != effectsToReplace.cend() ) {
+            const M82::SoundType soundType = [addIter, replaceIter, &effectsToAdd, &effectsToReplace]() {
+                if ( addIter == effectsToAdd.cend() ) {
+                    return replaceIter->soundType;
                 }
 
-                ++soundToAddIter;
+                if ( replaceIter == effectsToReplace.cend() ) {
+                    return addIter->soundType;
+                }
+
+                return std::min( addIter->soundType, replaceIter->soundType );
+            }();
+
+            soundTypeEffectsToAdd.clear();
+            soundTypeEffectsToReplace.clear();
+
+            for ( ; addIter != effectsToAdd.cend() && addIter->soundType == soundType; ++addIter ) {
+                soundTypeEffectsToAdd.emplace_back( *addIter );
+            }
+
+            for ( ; replaceIter != effectsToReplace.cend() && replaceIter->soundType == soundType; ++replaceIter ) {
+                soundTypeEffectsToReplace.emplace_back( *replaceIter );
             }
 
-            size_t effectsToReplaceCount = std::min( effectsToAdd.size(), effectsToReplace.size() );
+            size_t effectsToReplaceCount = std::min( soundTypeEffectsToAdd.size(), soundTypeEffectsToReplace.size() );
 
             while ( effectsToReplaceCount > 0 ) {
                 --effectsToReplaceCount;
@@ -711,69 +909,51 @@ namespace
                 // Find the closest angles to those which are going to be added.
                 size_t soundToAddId = 0;
                 size_t soundToReplaceId = 0;
-                getClosestSoundIdPairByAngle( effectsToAdd, effectsToReplace, soundToAddId, soundToReplaceId );
+                getClosestSoundIdPairByAngle( soundTypeEffectsToAdd, soundTypeEffectsToReplace, soundToAddId, soundToReplaceId );
 
-                currentAudioLoopEffects[soundType].emplace_back( effectsToReplace[soundToReplaceId] );
-                effectsToReplace.erase( effectsToReplace.begin() + static_cast<ptrdiff_t>( soundToReplaceId ) );
+                const ChannelAudioLoopEffectInfo & currentInfo
+                    = currentAudioLoopEffects.emplace_back( soundTypeEffectsToAdd[soundToAddId], soundTypeEffectsToReplace[soundToReplaceId].channelId );
 
-                ChannelAudioLoopEffectInfo & currentInfo = currentAudioLoopEffects[soundType].back();
-                currentInfo = { effectsToAdd[soundToAddId], currentInfo.channelId };
-                effectsToAdd.erase( effectsToAdd.begin() + static_cast<ptrdiff_t>( soundToAddId ) );
+                soundTypeEffectsToAdd.erase( soundTypeEffectsToAdd.begin() + static_cast<ptrdiff_t>( soundToAddId ) );
+                soundTypeEffectsToReplace.erase( soundTypeEffectsToReplace.begin() + static_cast<ptrdiff_t>( soundToReplaceId ) );
 
                 assert( is3DAudioEnabled || currentInfo.angle == 0 );
 
                 Mixer::setPosition( currentInfo.channelId, currentInfo.angle, currentInfo.distance );
             }
 
-            if ( effectsToReplace.empty() ) {
-                tempAudioLoopEffects.erase( foundSoundTypeIter );
-            }
-
-            if ( effectsToAdd.empty() ) {
-                iter = soundEffects.erase( iter );
-            }
-            else {
-                ++iter;
-            }
+            effectsToPlay.insert( effectsToPlay.end(), soundTypeEffectsToAdd.begin(), soundTypeEffectsToAdd.end() );
+            effectsToStop.insert( effectsToStop.end(), soundTypeEffectsToReplace.begin(), soundTypeEffectsToReplace.end() );
         }
 
-        for ( const auto & audioEffectPair : tempAudioLoopEffects ) {
-            const std::vector<ChannelAudioLoopEffectInfo> & existingEffects = audioEffectPair.second;
-
-            for ( const ChannelAudioLoopEffectInfo & info : existingEffects ) {
-                Mixer::Stop( info.channelId );
-            }
+        // Stop the remaining sounds first to free up their channels for the new sounds.
+        for ( const ChannelAudioLoopEffectInfo & info : effectsToStop ) {
+            Mixer::Stop( info.channelId );
         }
 
-        tempAudioLoopEffects.clear();
-
         // Add new sound effects.
-        for ( const auto & audioEffectPair : soundEffects ) {
-            const M82::SoundType soundType = audioEffectPair.first;
-            const std::vector<AudioManager::AudioLoopEffectInfo> & effects = audioEffectPair.second;
-            assert( !effects.empty() );
-
-            for ( const AudioManager::AudioLoopEffectInfo & info : effects ) {
-                // It is a new sound effect. Register and play it.
-                const std::vector<uint8_t> & audioData = GetWAV( soundType );
-                if ( audioData.empty() ) {
-                    // Looks like nothing to play. Ignore it.
-                    continue;
-                }
+        for ( const AudioManager::AudioLoopEffectInfo & info : effectsToPlay ) {
+            // It is a new sound effect. Register and play it.
+            const std::vector<uint8_t> & audioData = GetWAV( info.soundType );
+            if ( audioData.empty() ) {
+                // Looks like nothing to play. Ignore it.
+                continue;
+            }
 
-                assert( is3DAudioEnabled || info.angle == 0 );
+            assert( is3DAudioEnabled || info.angle == 0 );
 
-                const int channelId = Mixer::Play( audioData.data(), static_cast<uint32_t>( audioData.size() ), true, std::pair{ info.angle, info.distance } );
-                if ( channelId < 0 ) {
-                    // Unable to play this sound.
-                    continue;
-                }
+            const int channelId = Mixer::Play( audioData.data(), static_cast<uint32_t>( audioData.size() ), true, std::pair{ info.angle, info.distance } );
+            if ( channelId < 0 ) {
+                // Unable to play this sound.
+                continue;
+            }
 
-                currentAudioLoopEffects[soundType].emplace_back( info, channelId );
+            currentAudioLoopEffects.emplace_back( info, channelId );
 
-                DEBUG_LOG( DBG_GAME, DBG_TRACE, "Playing sound " << M82::GetString( soundType ) )
-            }
+            DEBUG_LOG( DBG_GAME, DBG_TRACE, "Playing sound " << M82::GetString( info.soundType ) )
         }
+
+        std::sort( currentAudioLoopEffects.begin(), currentAudioLoopEffects.end() );
     }
 }
 
@@ -827,7 +1007,7 @@ namespace AudioManager
         PlayMusicAsync( _music, Music::PlaybackMode::RESUME_AND_PLAY_INFINITE );
     }
 
-    void playLoopSoundsAsync( std::map<M82::SoundType, std::vector<AudioLoopEffectInfo>> soundEffects )
+    void playLoopSoundsAsync( std::vector<AudioLoopEffectInfo> soundEffects )
     {
         if ( !Audio::isValid() ) {
             return;
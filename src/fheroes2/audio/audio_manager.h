@@ -21,7 +21,6 @@
 #pragma once
 
 #include <cstdint>
-#include <map>
 #include <string>
 #include <vector>
 
@@ -72,10 +71,9 @@ namespace AudioManager
 
     struct AudioLoopEffectInfo
     {
-        AudioLoopEffectInfo() = default;
-
-        AudioLoopEffectInfo( const int16_t angle_, const uint8_t distance_ )
-            : angle( angle_ )
+        AudioLoopEffectInfo( const M82::SoundType soundType_, const int16_t angle_, const uint8_t distance_ )
+            : soundType( soundType_ )
+            , angle( angle_ )
             , distance( distance_ )
         {
             // Do nothing.
@@ -83,14 +81,29 @@ namespace AudioManager
 
         bool operator==( const AudioLoopEffectInfo & other ) const
         {
-            return other.angle == angle && other.distance == distance;
+            return other.soundType == soundType && other.angle == angle && other.distance == distance;
+        }
+
+        bool operator<( const AudioLoopEffectInfo & other ) const
+        {
+            if ( soundType != other.soundType ) {
+                return soundType < other.soundType;
+            }
+
+            if ( angle != other.angle ) {
+                return angle < other.angle;
+            }
+
+            return distance < other.distance;
         }
 
+        M82::SoundType soundType;
         int16_t angle{ 0 };
         uint8_t distance{ 0 };
     };
 
-    void playLoopSoundsAsync( std::map<M82::SoundType, std::vector<AudioLoopEffectInfo>> soundEffects );
+    // Sound effects should be sorted in ascending order. Only the effects that have changed since the previous call are applied to the mixer.
+    void playLoopSoundsAsync( std::vector<AudioLoopEffectInfo> soundEffects );
 
     // Returns the ID of the channel occupied by the sound being played, or a negative value (-1) in case of failure.
     int PlaySound( const int m82 );
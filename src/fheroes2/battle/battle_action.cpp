@@ -45,6 +45,7 @@
 #include "battle_command.h"
 #include "battle_grave.h"
 #include "battle_interface.h"
+#include "battle_record.h"
 #include "battle_tower.h"
 #include "battle_troop.h"
 #include "color.h"
@@ -394,6 +395,15 @@ void Battle::Arena::moveUnit( Unit * unit, const int32_t dst )
 
 void Battle::Arena::ApplyAction( Command & cmd )
 {
+    if ( _record ) {
+        if ( _record->isPlayback() ) {
+            _record->checkAppliedCommand( cmd );
+        }
+        else {
+            _record->addAppliedCommand( cmd );
+        }
+    }
+
     switch ( cmd.GetType() ) {
     case CommandType::SPELLCAST:
         ApplyActionSpellCast( cmd );
@@ -1404,7 +1414,10 @@ void Battle::Arena::ApplyActionAutoFinish( const Command & /* cmd */ )
         _autoBattleColors |= army2Color;
     }
 
+    // The rest of the battle is resolved in the same way as an auto resolved battle: without any rendering, animations, delays and
+    // the message log. The order of units is used only by the interface, so there is no need to maintain it anymore.
     _interface.reset();
+    _orderOfUnits.reset();
 }
 
 void Battle::Arena::ApplyActionSpellSummonElemental( const Command & /* cmd */, const Spell & spell )
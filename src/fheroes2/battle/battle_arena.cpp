@@ -46,6 +46,7 @@
 #include "battle_cell.h"
 #include "battle_command.h"
 #include "battle_interface.h"
+#include "battle_record.h"
 #include "battle_tower.h"
 #include "battle_troop.h"
 #include "castle.h"
@@ -435,6 +436,13 @@ void Battle::Arena::UnitTurn( const Units & orderHistory )
 
         if ( _interface ) {
             _interface->getPendingActions( actions );
+
+            if ( _record ) {
+                _record->addPendingInput( actions );
+            }
+        }
+        else if ( _record && _record->isPlayback() ) {
+            _record->getPendingInput( actions );
         }
 
         if ( !actions.empty() ) {
@@ -463,10 +471,20 @@ void Battle::Arena::UnitTurn( const Units & orderHistory )
             if ( ( _currentUnit->GetCurrentControl() & CONTROL_AI ) || ( _currentUnit->GetCurrentColor() & _autoBattleColors ) ) {
                 AI::BattlePlanner::Get().BattleTurn( *this, *_currentUnit, actions );
             }
+            else if ( _interface ) {
+                _interface->HumanTurn( *_currentUnit, actions );
+
+                if ( _record ) {
+                    _record->addTurnInput( actions );
+                }
+            }
             else {
-                assert( _interface != nullptr );
+                assert( _record != nullptr && _record->isPlayback() );
 
-                _interface->HumanTurn( *_currentUnit, actions );
+                if ( !_record->getTurnInput( actions ) ) {
+                    // The recorded battle has desynced, let AI finish it
+                    actions.emplace_back( Command::AUTO_FINISH );
+                }
             }
         }
 
@@ -500,6 +518,25 @@ void Battle::Arena::UnitTurn( const Units & orderHistory )
     }
 }
 
+void Battle::Arena::attachRecord( BattleRecord * record )
+{
+    assert( _turnNumber == 0 );
+
+    _record = record;
+
+    if ( _record == nullptr ) {
+        return;
+    }
+
+    if ( _record->isPlayback() ) {
+        // The human player's input is taken from the record, so the auto battle mode should be exactly the same as in the recorded battle
+        _autoBattleColors = _record->getInitialAutoBattleColors();
+    }
+    else {
+        _record->setInitialAutoBattleColors( _autoBattleColors );
+    }
+}
+
 bool Battle::Arena::BattleValid() const
 {
     return _army1->isValid() && _army2->isValid() && 0 == result_game.army1 && 0 == result_game.army2;
@@ -25,6 +25,7 @@
 #define H2BATTLE_ARENA_H
 
 #include <array>
+#include <bitset>
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -73,6 +74,8 @@ namespace Battle
     class Actions : public std::list<Command>
     {};
 
+    class BattleRecord;
+
     class TroopsUidGenerator
     {
     public:
@@ -105,6 +108,10 @@ namespace Battle
         void Turns();
         bool BattleValid() const;
 
+        // Attaches the battle record which is either filled in during the battle or used to play the battle back. This method should be
+        // called before the first turn.
+        void attachRecord( BattleRecord * record );
+
         bool AutoBattleInProgress() const;
         bool EnemyOfAIHasAutoBattleInProgress() const;
         bool CanToggleAutoBattle() const;
@@ -190,6 +197,12 @@ namespace Battle
             return _battlePathfinder.getClosestReachablePosition( unit, position );
         }
 
+        // Returns the cells that can be used as a destination for the given unit on its next turn (see BattleThreatMap for details)
+        const std::bitset<ARENASIZE> & getNextTurnReachableCells( const Unit & unit )
+        {
+            return _threatMap.getNextTurnReachableCells( unit );
+        }
+
         void ApplyAction( Command & );
 
         // Returns a list of targets that will be affected by the given spell casted by the given hero and applied
@@ -330,6 +343,7 @@ namespace Battle
 
         Board board;
         BattlePathfinder _battlePathfinder;
+        BattleThreatMap _threatMap;
         int _covrIcnId{ ICN::UNKNOWN };
 
         uint32_t _turnNumber{ 0 };
@@ -345,6 +359,8 @@ namespace Battle
 
         TroopsUidGenerator _uidGenerator;
 
+        BattleRecord * _record{ nullptr };
+
         enum
         {
             CHAIN_LIGHTNING_CREATURE_COUNT = 4
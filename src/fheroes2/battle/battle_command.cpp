@@ -25,6 +25,7 @@
 
 #include <algorithm>
 
+#include "serialize.h"
 #include "tools.h"
 
 int Battle::Command::GetNextValue()
@@ -91,3 +92,22 @@ Battle::Command & Battle::Command::operator>>( int & val )
 
     return *this;
 }
+
+OStreamBase & Battle::operator<<( OStreamBase & stream, const Command & cmd )
+{
+    using CommandTypeUnderlyingType = std::underlying_type_t<CommandType>;
+
+    return stream << static_cast<CommandTypeUnderlyingType>( cmd._type ) << static_cast<const std::vector<int> &>( cmd );
+}
+
+IStreamBase & Battle::operator>>( IStreamBase & stream, Command & cmd )
+{
+    using CommandTypeUnderlyingType = std::underlying_type_t<CommandType>;
+
+    CommandTypeUnderlyingType type = 0;
+    stream >> type >> static_cast<std::vector<int> &>( cmd );
+
+    cmd._type = static_cast<CommandType>( type );
+
+    return stream;
+}
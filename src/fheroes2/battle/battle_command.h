@@ -34,6 +34,9 @@
 
 #include "spell.h"
 
+class IStreamBase;
+class OStreamBase;
+
 namespace Battle
 {
     enum class CommandType : int32_t
@@ -137,11 +140,27 @@ namespace Battle
 
         Command & operator<<( const int val );
 
+        bool operator==( const Command & other ) const
+        {
+            return _type == other._type && static_cast<const std::vector<int> &>( *this ) == other;
+        }
+
+        bool operator!=( const Command & other ) const
+        {
+            return !operator==( other );
+        }
+
     private:
+        friend OStreamBase & operator<<( OStreamBase & stream, const Command & cmd );
+        friend IStreamBase & operator>>( IStreamBase & stream, Command & cmd );
+
         Command & operator>>( int & val );
 
         CommandType _type;
     };
+
+    OStreamBase & operator<<( OStreamBase & stream, const Command & cmd );
+    IStreamBase & operator>>( IStreamBase & stream, Command & cmd );
 }
 
 namespace std
@@ -25,8 +25,10 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <ostream>
 #include <set>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -38,6 +40,7 @@
 #include "battle.h" // IWYU pragma: associated
 #include "battle_arena.h"
 #include "battle_army.h"
+#include "battle_record.h"
 #include "campaign_savedata.h"
 #include "captain.h"
 #include "dialog.h"
@@ -54,6 +57,7 @@
 #include "skill.h"
 #include "spell.h"
 #include "spell_storage.h"
+#include "system.h"
 #include "tools.h"
 #include "translations.h"
 #include "ui_dialog.h"
@@ -112,6 +116,8 @@ namespace
                 break;
             }
         }
+
+        Army::invalidateStrengthCache();
     }
 
     void clearArtifacts( BagArtifacts & bag )
@@ -121,6 +127,8 @@ namespace
                 artifact = Artifact::UNKNOWN;
             }
         }
+
+        Army::invalidateStrengthCache();
     }
 
     uint32_t computeBattleSeed( const int32_t mapIndex, const uint32_t mapSeed, const Army & army1, const Army & army2 )
@@ -152,6 +160,25 @@ namespace
         return seed;
     }
 
+#if defined( WITH_DEBUG )
+    void saveBattleRecord( const Battle::BattleRecord & record, const int32_t mapIndex, const uint32_t battleSeed )
+    {
+        const std::string recordsDir = Battle::getBattleRecordsDirectory();
+        if ( !System::IsDirectory( recordsDir ) && !System::MakeDirectory( recordsDir ) ) {
+            ERROR_LOG( "Unable to create the directory for battle records: " << recordsDir )
+            return;
+        }
+
+        std::ostringstream os;
+        os << world.GetMapSeed() << '_' << world.CountDay() << '_' << mapIndex << '_' << battleSeed << ".fh2b";
+
+        const std::string filePath = System::concatPath( recordsDir, os.str() );
+        if ( !record.save( filePath ) ) {
+            ERROR_LOG( "Unable to save the battle record to " << filePath )
+        }
+    }
+#endif
+
     uint32_t getBattleResult( const uint32_t army )
     {
         if ( army & Battle::RESULT_SURRENDER )
@@ -372,9 +399,23 @@ Battle::Result Battle::Loader( Army & army1, Army & army2, int32_t mapsindex )
     const uint32_t battleSeed = computeBattleSeed( mapsindex, world.GetMapSeed(), army1, army2 );
 
     while ( true ) {
+#if defined( WITH_DEBUG )
+        // The record should be destroyed after the arena
+        std::unique_ptr<BattleRecord> record;
+
+        if ( IS_DEBUG( DBG_BATTLE, DBG_INFO ) ) {
+            record = std::make_unique<BattleRecord>();
+            record->setInitialState( army1, army2, mapsindex, world.GetMapSeed(), battleSeed );
+        }
+#endif
+
         Rand::DeterministicRandomGenerator randomGenerator( battleSeed );
         Arena arena( army1, army2, mapsindex, showBattle, randomGenerator );
 
+#if defined( WITH_DEBUG )
+        arena.attachRecord( record.get() );
+#endif
+
         DEBUG_LOG( DBG_BATTLE, DBG_INFO, "army1 " << army1.String() )
         DEBUG_LOG( DBG_BATTLE, DBG_INFO, "army2 " << army2.String() )
 
@@ -383,6 +424,14 @@ Battle::Result Battle::Loader( Army & army1, Army & army2, int32_t mapsindex )
         }
         result = arena.GetResult();
 
+#if defined( WITH_DEBUG )
+        if ( record ) {
+            record->setOutcome( arena );
+
+            saveBattleRecord( *record, mapsindex, battleSeed );
+        }
+#endif
+
         HeroBase * const winnerHero = ( result.army1 & RESULT_WINS ? commander1 : ( result.army2 & RESULT_WINS ? commander2 : nullptr ) );
         HeroBase * const loserHero = ( result.army1 & RESULT_LOSS ? commander1 : ( result.army2 & RESULT_LOSS ? commander2 : nullptr ) );
         const uint32_t lossResult = result.army1 & RESULT_LOSS ? result.army1 : result.army2;
@@ -21,6 +21,7 @@
 #include "battle_pathfinding.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -38,6 +39,22 @@
 namespace
 {
     const uint32_t MOAT_PENALTY = UINT16_MAX;
+
+    std::array<bool, ARENASIZE> getBoardStatus()
+    {
+        const Battle::Board * board = Battle::Arena::GetBoard();
+        assert( board != nullptr );
+
+        std::array<bool, ARENASIZE> boardStatus{};
+        for ( const Battle::Cell & cell : *board ) {
+            const int32_t cellIdx = cell.GetIndex();
+            assert( Battle::Board::isValidIndex( cellIdx ) );
+
+            boardStatus[cellIdx] = cell.isPassable( true );
+        }
+
+        return boardStatus;
+    }
 }
 
 namespace Battle
@@ -51,13 +68,7 @@ namespace Battle
 
         // Passability of the board cells can change during the unit's turn even without its intervention (for example, because of a hero's spell cast),
         // we need to keep track of this
-        std::array<bool, ARENASIZE> boardStatus{};
-        for ( const Cell & cell : *board ) {
-            const int32_t cellIdx = cell.GetIndex();
-            assert( Board::isValidIndex( cellIdx ) );
-
-            boardStatus[cellIdx] = cell.isPassable( true );
-        }
+        const std::array<bool, ARENASIZE> boardStatus = getBoardStatus();
 
         auto currentSettings = std::tie( _pathStart, _speed, _isWide, _isFlying, _color, _boardStatus );
         const auto newSettings = std::make_tuple( BattleNodeIndex{ unit.GetHeadIndex(), unit.GetTailIndex() }, unit.GetSpeed(), unit.isWide(), unit.isFlying(),
@@ -306,6 +317,37 @@ namespace Battle
         return result;
     }
 
+    std::bitset<ARENASIZE> BattlePathfinder::getReachableCells( const Unit & unit, const uint32_t speed )
+    {
+        reEvaluateIfNeeded( unit );
+
+        std::bitset<ARENASIZE> result;
+
+        for ( const auto & [index, node] : _cache ) {
+            if ( ( index != _pathStart && node._from == BattleNodeIndex{ -1, -1 } ) || node._cost > speed ) {
+                continue;
+            }
+
+            const auto [headCellIdx, tailCellIdx] = index;
+            assert( Board::isValidIndex( headCellIdx ) );
+
+            if ( _isWide ) {
+                assert( Board::isValidIndex( tailCellIdx ) );
+
+                // Positions with the reversed orientation cannot be obtained using the head or tail cell as a destination
+                if ( ( headCellIdx < tailCellIdx ) != unit.isReflect() ) {
+                    continue;
+                }
+
+                result.set( static_cast<size_t>( tailCellIdx ) );
+            }
+
+            result.set( static_cast<size_t>( headCellIdx ) );
+        }
+
+        return result;
+    }
+
     Indexes BattlePathfinder::buildPath( const Unit & unit, const Position & position )
     {
         assert( position.GetHead() != nullptr );
@@ -421,4 +463,56 @@ namespace Battle
 
         return {};
     }
+
+    const std::bitset<ARENASIZE> & BattleThreatMap::getNextTurnReachableCells( const Unit & unit )
+    {
+        assert( unit.GetHeadIndex() != -1 && ( unit.isWide() ? unit.GetTailIndex() != -1 : unit.GetTailIndex() == -1 ) );
+
+        // Any change in the passability of the board cells can affect the reachability for all units
+        const std::array<bool, ARENASIZE> boardStatus = getBoardStatus();
+        if ( boardStatus != _boardStatus ) {
+            _boardStatus = boardStatus;
+
+            _cache.clear();
+        }
+
+        const BattleNodeIndex position{ unit.GetHeadIndex(), unit.GetTailIndex() };
+        // Also consider the next turn, even if this unit has already acted during the current turn
+        const uint32_t speed = unit.GetSpeed( false, true );
+        const int color = unit.GetColor();
+
+        const auto [iter, inserted] = _cache.try_emplace( unit.GetUID() );
+        UnitReachability & reachability = iter->second;
+
+        if ( !inserted && reachability.position == position && reachability.speed == speed && reachability.color == color ) {
+            return reachability.reachableCells;
+        }
+
+        reachability.position = position;
+        reachability.speed = speed;
+        reachability.color = color;
+
+        // Immovable unit is not taken into account, even if it is already near some position
+        if ( speed == Speed::STANDING ) {
+            reachability.reachableCells.reset();
+        }
+        else {
+            reachability.reachableCells = _pathfinder.getReachableCells( unit, speed );
+        }
+
+        return reachability.reachableCells;
+    }
+
+    bool BattleThreatMap::isPositionApproachable( const std::bitset<ARENASIZE> & reachableCells, const Position & position )
+    {
+        for ( const int32_t nearbyIdx : Board::GetAroundIndexes( position ) ) {
+            assert( Board::isValidIndex( nearbyIdx ) );
+
+            if ( reachableCells.test( static_cast<size_t>( nearbyIdx ) ) ) {
+                return true;
+            }
+        }
+
+        return false;
+    }
 }
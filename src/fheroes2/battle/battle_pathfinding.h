@@ -21,6 +21,7 @@
 #pragma once
 
 #include <array>
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <unordered_map>
@@ -97,6 +98,11 @@ namespace Battle
         // Returns the indexes of all cells that can be occupied by the given unit's head on the current turn
         Indexes getAllAvailableMoves( const Unit & unit );
 
+        // Returns the cells that, being used as a destination for the given unit, give positions that are reachable by this unit with the given
+        // number of movement points (see Position::GetReachable() for details). For wide units, only the positions with the same orientation
+        // as the current one are considered, and both the head and tail cells of these positions are taken into account.
+        std::bitset<ARENASIZE> getReachableCells( const Unit & unit, const uint32_t speed );
+
         // Returns the position on the path for the given unit to the given position, which is reachable on the current
         // turn and is as close as possible to the destination (excluding the current position of the unit). If the given
         // position is unreachable by the given unit, then an empty Position object is returned.
@@ -118,4 +124,47 @@ namespace Battle
         // Board cells passability status at the time of current cache creation
         std::array<bool, ARENASIZE> _boardStatus{};
     };
+
+    // Map of threats posed by units, i.e. the cells that each unit is able to reach on its next turn. The reachability of each unit is cached
+    // separately and is re-evaluated only when the parameters of this particular unit or the passability of the board cells change, so AI can
+    // evaluate the threats posed by all enemy units to various positions without rebuilding the graph of positions available for each enemy
+    // unit over and over again.
+    class BattleThreatMap final
+    {
+    public:
+        BattleThreatMap() = default;
+        BattleThreatMap( const BattleThreatMap & ) = delete;
+
+        ~BattleThreatMap() = default;
+
+        BattleThreatMap & operator=( const BattleThreatMap & ) = delete;
+
+        // Returns the cells that can be used as a destination for the given unit on its next turn (see Position::GetReachable() for details).
+        // The returned reference remains valid until the next call of this method.
+        const std::bitset<ARENASIZE> & getNextTurnReachableCells( const Unit & unit );
+
+        // Checks whether the given position can be approached (i.e. any of the cells adjacent to this position can be reached) by a unit with
+        // the given set of reachable cells
+        static bool isPositionApproachable( const std::bitset<ARENASIZE> & reachableCells, const Position & position );
+
+    private:
+        struct UnitReachability
+        {
+            // Parameters of the unit for which the reachable cells are evaluated
+            BattleNodeIndex position{ -1, -1 };
+            uint32_t speed{ 0 };
+            int color{ 0 };
+
+            std::bitset<ARENASIZE> reachableCells;
+        };
+
+        // Separate pathfinder is used in order not to invalidate the cache of the arena's pathfinder, which is used for the current unit
+        BattlePathfinder _pathfinder;
+
+        // Reachability of units by their UIDs
+        std::unordered_map<uint32_t, UnitReachability> _cache;
+
+        // Board cells passability status at the time of current cache creation
+        std::array<bool, ARENASIZE> _boardStatus{};
+    };
 }
@@ -0,0 +1,515 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2024                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "battle_record.h"
+
+#include <array>
+#include <cassert>
+#include <memory>
+#include <ostream>
+#include <utility>
+
+#include "army.h"
+#include "battle.h"
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "battle_troop.h"
+#include "captain.h"
+#include "castle.h"
+#include "dir.h"
+#include "game_io.h"
+#include "heroes.h"
+#include "heroes_base.h"
+#include "kingdom.h"
+#include "logging.h"
+#include "maps.h"
+#include "rand.h"
+#include "resource.h"
+#include "save_format_version.h"
+#include "serialize.h"
+#include "system.h"
+#include "timing.h"
+#include "tools.h"
+#include "world.h"
+#include "zzlib.h"
+
+namespace
+{
+    const uint16_t battleRecordId = 0xFB01;
+
+    // Increase this version every time the layout of the record file changes
+    const uint16_t battleRecordFormatVersion = 1;
+
+    const std::string battleRecordFileExtension{ ".fh2b" };
+
+    // Restores the state of the world which could be changed by the replayed battle
+    class WorldStateRestorer
+    {
+    public:
+        WorldStateRestorer( Army & army1, Army & army2 )
+        {
+            for ( Army * army : { &army1, &army2 } ) {
+                const int color = army->GetColor();
+
+                _funds.emplace_back( color, world.GetKingdom( color ).GetFunds() );
+
+                // Heroes are restored from the record, but castle captains are the real ones
+                HeroBase * commander = army->GetCommander();
+                if ( commander != nullptr && commander->isCaptain() ) {
+                    _captainSpellPoints.emplace_back( commander, commander->GetSpellPoints() );
+                }
+            }
+        }
+
+        WorldStateRestorer( const WorldStateRestorer & ) = delete;
+
+        ~WorldStateRestorer()
+        {
+            for ( const auto & [color, funds] : _funds ) {
+                Kingdom & kingdom = world.GetKingdom( color );
+
+                kingdom.OddFundsResource( kingdom.GetFunds() - funds );
+            }
+
+            for ( const auto & [captain, spellPoints] : _captainSpellPoints ) {
+                captain->SetSpellPoints( spellPoints );
+            }
+        }
+
+        WorldStateRestorer & operator=( const WorldStateRestorer & ) = delete;
+
+    private:
+        std::vector<std::pair<int, Funds>> _funds;
+        std::vector<std::pair<HeroBase *, uint32_t>> _captainSpellPoints;
+    };
+}
+
+void Battle::BattleRecord::setInitialState( const Army & army1, const Army & army2, const int32_t tileIndex, const uint32_t mapSeed, const uint32_t battleSeed )
+{
+    const auto storeArmyState = []( const Army & army, ArmyState & state ) {
+        RWStreamBuf stream;
+        stream.setBigendian( true );
+
+        const HeroBase * commander = army.GetCommander();
+
+        if ( commander != nullptr && commander->isHeroes() ) {
+            const Heroes * hero = dynamic_cast<const Heroes *>( commander );
+            assert( hero != nullptr );
+
+            state.commanderType = ArmyState::CommanderType::HERO;
+
+            stream << *hero;
+        }
+        else if ( army.inCastle() ) {
+            state.commanderType = ArmyState::CommanderType::CASTLE;
+        }
+        else {
+            state.commanderType = ArmyState::CommanderType::NONE;
+        }
+
+        stream << army;
+
+        state.control = army.GetControl();
+        state.data.assign( stream.data(), stream.data() + stream.size() );
+    };
+
+    storeArmyState( army1, _army1 );
+    storeArmyState( army2, _army2 );
+
+    _heroesFormatVersion = static_cast<uint16_t>( CURRENT_FORMAT_VERSION );
+
+    _tileIndex = tileIndex;
+    _mapSeed = mapSeed;
+    _battleSeed = battleSeed;
+
+    _entries.clear();
+    _outcomeHash = 0;
+    _isPlayback = false;
+}
+
+void Battle::BattleRecord::addPendingInput( const Actions & actions )
+{
+    assert( !_isPlayback );
+
+    for ( const Command & cmd : actions ) {
+        _entries.push_back( { EntryType::PENDING_INPUT, cmd } );
+    }
+}
+
+void Battle::BattleRecord::addTurnInput( const Actions & actions )
+{
+    assert( !_isPlayback );
+
+    for ( const Command & cmd : actions ) {
+        _entries.push_back( { EntryType::TURN_INPUT, cmd } );
+    }
+}
+
+void Battle::BattleRecord::addAppliedCommand( const Command & cmd )
+{
+    assert( !_isPlayback );
+
+    _entries.push_back( { EntryType::APPLIED_COMMAND, cmd } );
+}
+
+void Battle::BattleRecord::setOutcome( Arena & arena )
+{
+    _outcomeHash = calculateOutcomeHash( arena );
+}
+
+bool Battle::BattleRecord::save( const std::string & filePath ) const
+{
+    DEBUG_LOG( DBG_BATTLE, DBG_INFO, filePath )
+
+    StreamFile fileStream;
+    fileStream.setBigendian( true );
+
+    if ( !fileStream.open( filePath, "wb" ) ) {
+        return false;
+    }
+
+    fileStream << battleRecordId << battleRecordFormatVersion << _heroesFormatVersion << _tileIndex << _mapSeed << _battleSeed;
+    if ( fileStream.fail() ) {
+        return false;
+    }
+
+    RWStreamBuf dataStream;
+    dataStream.setBigendian( true );
+
+    for ( const ArmyState * state : { &_army1, &_army2 } ) {
+        dataStream << static_cast<uint8_t>( state->commanderType ) << state->control << state->data;
+    }
+
+    dataStream << _initialAutoBattleColors << static_cast<uint32_t>( _entries.size() );
+
+    for ( const Entry & entry : _entries ) {
+        dataStream << static_cast<uint8_t>( entry.type ) << entry.command;
+    }
+
+    dataStream << _outcomeHash << battleRecordId;
+
+    return !dataStream.fail() && Compression::zipStreamBuf( dataStream, fileStream );
+}
+
+bool Battle::BattleRecord::load( const std::string & filePath )
+{
+    DEBUG_LOG( DBG_BATTLE, DBG_INFO, filePath )
+
+    StreamFile fileStream;
+    fileStream.setBigendian( true );
+
+    if ( !fileStream.open( filePath, "rb" ) ) {
+        return false;
+    }
+
+    uint16_t recordId = 0;
+    uint16_t recordFormatVersion = 0;
+
+    fileStream >> recordId >> recordFormatVersion >> _heroesFormatVersion >> _tileIndex >> _mapSeed >> _battleSeed;
+    if ( fileStream.fail() || recordId != battleRecordId || recordFormatVersion != battleRecordFormatVersion ) {
+        DEBUG_LOG( DBG_BATTLE, DBG_WARN, "Invalid or unsupported battle record " << filePath )
+        return false;
+    }
+
+    if ( _heroesFormatVersion > CURRENT_FORMAT_VERSION || _heroesFormatVersion < LAST_SUPPORTED_FORMAT_VERSION ) {
+        DEBUG_LOG( DBG_BATTLE, DBG_WARN, "Unsupported save format version " << _heroesFormatVersion << " of the battle record " << filePath )
+        return false;
+    }
+
+    RWStreamBuf dataStream;
+    dataStream.setBigendian( true );
+
+    if ( !Compression::unzipStream( fileStream, dataStream ) ) {
+        return false;
+    }
+
+    for ( ArmyState * state : { &_army1, &_army2 } ) {
+        uint8_t commanderType = 0;
+
+        dataStream >> commanderType >> state->control >> state->data;
+
+        state->commanderType = static_cast<ArmyState::CommanderType>( commanderType );
+    }
+
+    uint32_t entriesCount = 0;
+    dataStream >> _initialAutoBattleColors >> entriesCount;
+
+    _entries.clear();
+
+    for ( uint32_t i = 0; i < entriesCount && !dataStream.fail(); ++i ) {
+        uint8_t type = 0;
+        dataStream >> type;
+
+        // The contents of this placeholder command will be fully overwritten
+        Entry & entry = _entries.emplace_back( Entry{ static_cast<EntryType>( type ), Command( Command::AUTO_FINISH ) } );
+        dataStream >> entry.command;
+    }
+
+    uint16_t endOfDataMarker = 0;
+    dataStream >> _outcomeHash >> endOfDataMarker;
+
+    return !dataStream.fail() && endOfDataMarker == battleRecordId;
+}
+
+bool Battle::BattleRecord::getInput( const EntryType type, Actions & actions )
+{
+    assert( _isPlayback );
+
+    if ( _playbackPos >= _entries.size() || _entries[_playbackPos].type != type ) {
+        return false;
+    }
+
+    // All consecutive entries of the same type belong to the same input, all of them are followed by the applied commands
+    for ( size_t pos = _playbackPos; pos < _entries.size() && _entries[pos].type == type; ++pos ) {
+        actions.push_back( _entries[pos].command );
+    }
+
+    while ( _playbackPos < _entries.size() && _entries[_playbackPos].type == type ) {
+        ++_playbackPos;
+    }
+
+    return true;
+}
+
+bool Battle::BattleRecord::getPendingInput( Actions & actions )
+{
+    return getInput( EntryType::PENDING_INPUT, actions );
+}
+
+bool Battle::BattleRecord::getTurnInput( Actions & actions )
+{
+    if ( getInput( EntryType::TURN_INPUT, actions ) ) {
+        return true;
+    }
+
+    DEBUG_LOG( DBG_BATTLE, DBG_WARN, "Desync detected: no recorded input of the human player, entry " << _playbackPos )
+
+    _isDesynced = true;
+
+    return false;
+}
+
+void Battle::BattleRecord::checkAppliedCommand( const Command & cmd )
+{
+    assert( _isPlayback );
+
+    if ( _isDesynced ) {
+        return;
+    }
+
+    if ( _playbackPos >= _entries.size() || _entries[_playbackPos].type != EntryType::APPLIED_COMMAND || _entries[_playbackPos].command != cmd ) {
+        DEBUG_LOG( DBG_BATTLE, DBG_WARN, "Desync detected: the applied command does not match the recorded one, entry " << _playbackPos )
+
+        _isDesynced = true;
+
+        return;
+    }
+
+    ++_playbackPos;
+}
+
+bool Battle::BattleRecord::replay()
+{
+    if ( _mapSeed != world.GetMapSeed() || !Maps::isValidAbsIndex( _tileIndex ) ) {
+        DEBUG_LOG( DBG_BATTLE, DBG_WARN, "This battle record was made on a different map" )
+        return false;
+    }
+
+    std::array<std::unique_ptr<Heroes>, 2> heroes;
+    std::array<std::unique_ptr<Army>, 2> armies;
+    std::array<Army *, 2> battleArmies{ nullptr, nullptr };
+
+    // Heroes are serialized in the save file format, so its version should be set accordingly
+    const uint16_t currentSaveFileVersion = Game::GetVersionOfCurrentSaveFile();
+    Game::SetVersionOfCurrentSaveFile( _heroesFormatVersion );
+
+    for ( size_t idx = 0; idx < battleArmies.size(); ++idx ) {
+        const ArmyState & state = ( idx == 0 ? _army1 : _army2 );
+
+        ROStreamBuf stream( state.data );
+        stream.setBigendian( true );
+
+        switch ( state.commanderType ) {
+        case ArmyState::CommanderType::HERO:
+            heroes[idx] = std::make_unique<Heroes>();
+            stream >> *heroes[idx];
+
+            battleArmies[idx] = &heroes[idx]->GetArmy();
+            stream >> *battleArmies[idx];
+
+            battleArmies[idx]->SetCommander( heroes[idx].get() );
+            break;
+        case ArmyState::CommanderType::CASTLE: {
+            Castle * castle = world.getCastleEntrance( Maps::GetPoint( _tileIndex ) );
+            if ( castle == nullptr ) {
+                break;
+            }
+
+            armies[idx] = std::make_unique<Army>( &castle->GetCaptain() );
+            battleArmies[idx] = armies[idx].get();
+
+            stream >> *battleArmies[idx];
+
+            battleArmies[idx]->SetCommander( &castle->GetCaptain() );
+            break;
+        }
+        case ArmyState::CommanderType::NONE:
+            armies[idx] = std::make_unique<Army>();
+            battleArmies[idx] = armies[idx].get();
+
+            stream >> *battleArmies[idx];
+            break;
+        default:
+            break;
+        }
+
+        if ( battleArmies[idx] == nullptr || stream.fail() ) {
+            Game::SetVersionOfCurrentSaveFile( currentSaveFileVersion );
+
+            DEBUG_LOG( DBG_BATTLE, DBG_WARN, "Unable to restore the state of the army " << idx + 1 )
+            return false;
+        }
+
+        if ( battleArmies[idx]->GetControl() != state.control ) {
+            Game::SetVersionOfCurrentSaveFile( currentSaveFileVersion );
+
+            DEBUG_LOG( DBG_BATTLE, DBG_WARN, "The control type of the army " << idx + 1 << " does not match the recorded one" )
+            return false;
+        }
+    }
+
+    Game::SetVersionOfCurrentSaveFile( currentSaveFileVersion );
+
+    _isPlayback = true;
+    _isDesynced = false;
+    _playbackPos = 0;
+
+    uint32_t outcomeHash = 0;
+
+    {
+        const WorldStateRestorer worldStateRestorer( *battleArmies[0], *battleArmies[1] );
+
+        Rand::DeterministicRandomGenerator randomGenerator( _battleSeed );
+        Arena arena( *battleArmies[0], *battleArmies[1], _tileIndex, false, randomGenerator );
+
+        arena.attachRecord( this );
+
+        while ( arena.BattleValid() ) {
+            arena.Turns();
+        }
+
+        outcomeHash = calculateOutcomeHash( arena );
+    }
+
+    _isPlayback = false;
+
+    if ( outcomeHash != _outcomeHash ) {
+        DEBUG_LOG( DBG_BATTLE, DBG_WARN, "Desync detected: the outcome of the battle does not match the recorded one" )
+
+        _isDesynced = true;
+    }
+
+    return !_isDesynced;
+}
+
+uint32_t Battle::BattleRecord::calculateOutcomeHash( Arena & arena )
+{
+    const Result & result = arena.GetResult();
+
+    uint32_t hash = 0;
+
+    fheroes2::hashCombine( hash, result.army1 );
+    fheroes2::hashCombine( hash, result.army2 );
+    fheroes2::hashCombine( hash, result.exp1 );
+    fheroes2::hashCombine( hash, result.exp2 );
+    fheroes2::hashCombine( hash, result.killed );
+
+    for ( const Force * force : { &arena.GetForce1(), &arena.GetForce2() } ) {
+        for ( const Unit * unit : *force ) {
+            assert( unit != nullptr );
+
+            fheroes2::hashCombine( hash, unit->GetUID() );
+            fheroes2::hashCombine( hash, unit->GetID() );
+            fheroes2::hashCombine( hash, unit->GetCount() );
+            fheroes2::hashCombine( hash, unit->GetDead() );
+            fheroes2::hashCombine( hash, unit->GetHitPoints() );
+        }
+
+        const HeroBase * commander = force->GetCommander();
+        if ( commander != nullptr ) {
+            fheroes2::hashCombine( hash, commander->GetSpellPoints() );
+        }
+    }
+
+    return hash;
+}
+
+std::string Battle::getBattleRecordsDirectory()
+{
+    return System::concatPath( System::concatPath( System::GetDataDirectory( "fheroes2" ), "files" ), "battles" );
+}
+
+size_t Battle::replayBattleRecords( size_t & desyncCount )
+{
+    desyncCount = 0;
+
+    ListFiles files;
+    files.ReadDir( getBattleRecordsDirectory(), battleRecordFileExtension );
+
+    size_t replayedCount = 0;
+    uint64_t totalTimeMs = 0;
+
+    for ( const std::string & file : files ) {
+        BattleRecord record;
+        if ( !record.load( file ) ) {
+            VERBOSE_LOG( "Unable to load the battle record " << file )
+            continue;
+        }
+
+        if ( record.getMapSeed() != world.GetMapSeed() ) {
+            // This record belongs to a different map
+            continue;
+        }
+
+        const fheroes2::Time timer;
+
+        const bool isReplayed = record.replay();
+
+        const uint64_t timeMs = timer.getMs();
+        totalTimeMs += timeMs;
+
+        if ( !isReplayed && !record.isDesynced() ) {
+            VERBOSE_LOG( "Unable to replay the battle record " << file )
+            continue;
+        }
+
+        ++replayedCount;
+
+        if ( record.isDesynced() ) {
+            ++desyncCount;
+        }
+
+        VERBOSE_LOG( "Battle record " << file << ": " << ( record.isDesynced() ? "DESYNC" : "OK" ) << ", " << timeMs << " ms" )
+    }
+
+    VERBOSE_LOG( "Replayed battle records: " << replayedCount << ", desyncs: " << desyncCount << ", total time: " << totalTimeMs << " ms" )
+
+    return replayedCount;
+}
@@ -0,0 +1,160 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2024                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "battle_command.h"
+
+class Army;
+
+namespace Battle
+{
+    class Actions;
+    class Arena;
+
+    // The record of a single battle: the initial state of both armies, the seed of the random number generator and all the commands
+    // applied during the battle. Since the battle logic is deterministic, this is enough to re-run the same battle without the interface
+    // and check that its outcome remains exactly the same. The record can be either filled in during the battle or loaded from a file
+    // to play it back.
+    class BattleRecord
+    {
+    public:
+        BattleRecord() = default;
+        BattleRecord( const BattleRecord & ) = delete;
+
+        ~BattleRecord() = default;
+
+        BattleRecord & operator=( const BattleRecord & ) = delete;
+
+        // Recording part. The state of armies should be stored before the arena is created.
+        void setInitialState( const Army & army1, const Army & army2, const int32_t tileIndex, const uint32_t mapSeed, const uint32_t battleSeed );
+        void setInitialAutoBattleColors( const int colors )
+        {
+            _initialAutoBattleColors = colors;
+        }
+
+        // Human player's input received from the battle interface either before the turn of the current unit or during it
+        void addPendingInput( const Actions & actions );
+        void addTurnInput( const Actions & actions );
+
+        void addAppliedCommand( const Command & cmd );
+        void setOutcome( Arena & arena );
+
+        bool save( const std::string & filePath ) const;
+
+        // Playback part
+        bool load( const std::string & filePath );
+
+        bool isPlayback() const
+        {
+            return _isPlayback;
+        }
+
+        uint32_t getMapSeed() const
+        {
+            return _mapSeed;
+        }
+
+        int getInitialAutoBattleColors() const
+        {
+            return _initialAutoBattleColors;
+        }
+
+        // Return false if the next recorded entry is not a human player's input of the corresponding type
+        bool getPendingInput( Actions & actions );
+        bool getTurnInput( Actions & actions );
+
+        // Checks the applied command against the recorded one. Any mismatch is considered a desync.
+        void checkAppliedCommand( const Command & cmd );
+
+        bool isDesynced() const
+        {
+            return _isDesynced;
+        }
+
+        // Re-runs the recorded battle without the interface in the current world. Returns true if the battle has been replayed and its
+        // outcome matches the recorded one.
+        bool replay();
+
+        static uint32_t calculateOutcomeHash( Arena & arena );
+
+    private:
+        enum class EntryType : uint8_t
+        {
+            PENDING_INPUT,
+            TURN_INPUT,
+            APPLIED_COMMAND
+        };
+
+        struct Entry
+        {
+            EntryType type;
+            Command command;
+        };
+
+        // Initial state of an army: its troops along with the commander
+        struct ArmyState
+        {
+            enum class CommanderType : uint8_t
+            {
+                NONE,
+                HERO,
+                CASTLE
+            };
+
+            CommanderType commanderType{ CommanderType::NONE };
+            int control{ 0 };
+            // Serialized Heroes (if any) and Army instances
+            std::vector<uint8_t> data;
+        };
+
+        bool getInput( const EntryType type, Actions & actions );
+
+        ArmyState _army1;
+        ArmyState _army2;
+
+        // Version of the save file format used to serialize the heroes
+        uint16_t _heroesFormatVersion{ 0 };
+
+        int32_t _tileIndex{ -1 };
+        uint32_t _mapSeed{ 0 };
+        uint32_t _battleSeed{ 0 };
+        int _initialAutoBattleColors{ 0 };
+
+        std::vector<Entry> _entries;
+        uint32_t _outcomeHash{ 0 };
+
+        bool _isPlayback{ false };
+        bool _isDesynced{ false };
+        size_t _playbackPos{ 0 };
+    };
+
+    // Returns the path to the directory where battle records are stored
+    std::string getBattleRecordsDirectory();
+
+    // Replays all battle records that were made on the current map and logs the results along with the time spent for each battle.
+    // Returns the number of replayed records, 'desyncCount' is set to the number of records whose outcome does not match.
+    size_t replayBattleRecords( size_t & desyncCount );
+}
@@ -418,7 +418,7 @@ void BuildingInfo::Redraw() const
     }
 
     const fheroes2::Text buildingName( Castle::GetStringBuilding( _buildingType, castle.GetRace() ), fheroes2::FontType::smallWhite() );
-    buildingName.draw( area.x + 68 - buildingName.width() / 2, area.y + 61, display );
+    buildingName.drawCached( area.x + 68 - buildingName.width() / 2, area.y + 61, display );
 }
 
 const char * BuildingInfo::GetName() const
@@ -695,7 +695,7 @@ void DwellingsBar::RedrawItem( DwellingItem & dwl, const fheroes2::Rect & pos, f
 
     // Units available for hire.
     fheroes2::Text text( std::to_string( castle.getMonstersInDwelling( dwType ) ), fheroes2::FontType::smallWhite() );
-    text.draw( pos.x + pos.width - text.width() - 3, pos.y + pos.height - text.height() + 1, dstsf );
+    text.drawCached( pos.x + pos.width - text.width() - 3, pos.y + pos.height - text.height() + 1, dstsf );
 
     uint32_t grown = mons.GetGrown();
     if ( castle.isBuild( BUILD_WELL ) ) {
@@ -707,7 +707,7 @@ void DwellingsBar::RedrawItem( DwellingItem & dwl, const fheroes2::Rect & pos, f
 
     // Dwelling's growth.
     text.set( "+" + std::to_string( grown ), fheroes2::FontType::smallYellow() );
-    text.draw( pos.x + pos.width - text.width() - 3, pos.y + 4, dstsf );
+    text.drawCached( pos.x + pos.width - text.width() - 3, pos.y + 4, dstsf );
 }
 
 bool DwellingsBar::ActionBarLeftMouseSingleClick( DwellingItem & dwl )
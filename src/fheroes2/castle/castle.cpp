@@ -971,6 +971,9 @@ void Castle::ChangeColor( int cl )
 {
     SetColor( cl );
     army.SetColor( cl );
+
+    // All tiles of the castle are painted in the color of its owner on the radar.
+    world.markAreaForRadarUpdate( { center.x - 2, center.y - 3, 5, 5 } );
 }
 
 int Castle::GetLevelMageGuild() const
@@ -1417,6 +1420,9 @@ bool Castle::BuyBuilding( uint32_t build )
     // disable day build
     ResetModes( ALLOW_TO_BUILD_TODAY );
 
+    // New buildings may affect the morale and luck of armies in the castle, as well as the spells known by heroes
+    Army::invalidateStrengthCache();
+
     DEBUG_LOG( DBG_GAME, DBG_INFO, name << " build " << GetStringBuilding( build, race ) )
     return true;
 }
@@ -22,6 +22,7 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <ctime>
@@ -29,8 +30,10 @@
 #include <iterator>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -230,25 +233,91 @@ namespace
         // Do nothing.
     }
 
-    MapsFileInfoList getSortedMapsFileInfoList()
+    // Reads the headers of save files in a separate thread, so the dialog can be shown right away and filled in as the files are read.
+    class SaveFileScanner
     {
-        ListFiles files;
-        files.ReadDir( Game::GetSaveDir(), Game::GetSaveFileExtension() );
+    public:
+        explicit SaveFileScanner( ListFiles files )
+            : _files( std::move( files ) )
+        {
+            _thread = std::thread( [this]() { scan(); } );
+        }
+
+        SaveFileScanner( const SaveFileScanner & ) = delete;
+
+        ~SaveFileScanner()
+        {
+            _isStopRequested = true;
+            _thread.join();
+        }
+
+        SaveFileScanner & operator=( const SaveFileScanner & ) = delete;
 
-        MapsFileInfoList mapInfos;
-        mapInfos.reserve( files.size() );
+        size_t getFileCount() const
+        {
+            return _files.size();
+        }
+
+        bool isCompleted() const
+        {
+            return _isCompleted;
+        }
 
-        for ( std::string & saveFile : files ) {
-            Maps::FileInfo mapInfo;
+        // Moves the infos of the files read since the previous call to the given list. Returns false if there are no such files.
+        bool takeFileInfos( MapsFileInfoList & fileInfos )
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
 
-            if ( Game::LoadSAV2FileInfo( std::move( saveFile ), mapInfo ) ) {
-                mapInfos.emplace_back( std::move( mapInfo ) );
+            if ( _fileInfos.empty() ) {
+                return false;
             }
+
+            fileInfos.insert( fileInfos.end(), std::make_move_iterator( _fileInfos.begin() ), std::make_move_iterator( _fileInfos.end() ) );
+            _fileInfos.clear();
+
+            return true;
         }
 
-        std::sort( mapInfos.begin(), mapInfos.end(), Maps::FileInfo::sortByFileName );
+    private:
+        void scan()
+        {
+            for ( const std::string & saveFile : _files ) {
+                if ( _isStopRequested ) {
+                    break;
+                }
+
+                Maps::FileInfo mapInfo;
+
+                if ( Game::LoadSAV2FileInfo( saveFile, mapInfo ) ) {
+                    const std::scoped_lock<std::mutex> lock( _mutex );
+
+                    _fileInfos.emplace_back( std::move( mapInfo ) );
+                }
+            }
+
+            _isCompleted = true;
+        }
+
+        const ListFiles _files;
 
-        return mapInfos;
+        std::mutex _mutex;
+
+        MapsFileInfoList _fileInfos;
+
+        std::atomic<bool> _isStopRequested{ false };
+        std::atomic<bool> _isCompleted{ false };
+
+        std::thread _thread;
+    };
+
+    int findSaveFile( const MapsFileInfoList & lists, const std::string & filePath )
+    {
+        const auto iter = std::find_if( lists.begin(), lists.end(), [&filePath]( const Maps::FileInfo & info ) { return info.filename == filePath; } );
+        if ( iter == lists.end() ) {
+            return -1;
+        }
+
+        return static_cast<int>( std::distance( lists.begin(), iter ) );
     }
 
     std::string selectFileListSimple( const std::string & header, const std::string & lastfile, const bool isEditing )
@@ -256,7 +325,14 @@ namespace
         // setup cursor
         const CursorRestorer cursorRestorer( true, Cursor::POINTER );
 
-        MapsFileInfoList lists = getSortedMapsFileInfoList();
+        ListFiles files;
+        files.ReadDir( Game::GetSaveDir(), Game::GetSaveFileExtension() );
+
+        SaveFileScanner scanner( std::move( files ) );
+
+        // The list is filled in while the dialog is already shown
+        MapsFileInfoList lists;
+        lists.reserve( scanner.getFileCount() );
 
         const int32_t listHeightDeduction = 112;
         const int32_t listAreaOffsetY = 3;
@@ -265,7 +341,7 @@ namespace
         // If we don't have many save files, we reduce the maximum dialog height,
         // but not less than enough for 11 elements.
         // We also limit the maximum list height to 22 lines.
-        const int32_t maxDialogHeight = fheroes2::getFontHeight( fheroes2::FontSize::NORMAL ) * std::clamp( static_cast<int32_t>( lists.size() ), 11, 22 )
+        const int32_t maxDialogHeight = fheroes2::getFontHeight( fheroes2::FontSize::NORMAL ) * std::clamp( static_cast<int32_t>( scanner.getFileCount() ), 11, 22 )
                                         + listAreaOffsetY + listAreaHeightDeduction + listHeightDeduction;
 
         fheroes2::Display & display = fheroes2::Display::instance();
@@ -292,7 +368,8 @@ namespace
 
         // Prepare OKAY and CANCEL buttons and render their shadows.
         fheroes2::Button buttonOk;
-        if ( !isEditing && lists.empty() ) {
+        if ( !isEditing ) {
+            // Nothing can be loaded until at least one save file is read
             buttonOk.disable();
         }
         fheroes2::Button buttonCancel;
@@ -324,36 +401,68 @@ namespace
         listbox.SetListContent( lists );
         listbox.updateScrollBarImage();
 
-        std::string filename;
-        size_t charInsertPos = 0;
+        // When saving, the name of the last file is offered even if there is no such file yet. When loading, only an existing file can be chosen.
+        std::string filename = isEditing ? System::GetStem( lastfile ) : std::string{};
+        size_t charInsertPos = filename.size();
 
-        if ( !lastfile.empty() ) {
-            filename = System::GetStem( lastfile );
-            charInsertPos = filename.size();
+        // The initial selection may change while the list is being filled in, until the player makes their own choice.
+        bool isInitialSelectionPending = true;
 
-            MapsFileInfoList::iterator it = lists.begin();
-            for ( ; it != lists.end(); ++it ) {
-                if ( ( *it ).filename == lastfile ) {
-                    break;
-                }
+        const auto updateInitialSelection = [&lists, &lastfile, &listbox, &filename, &charInsertPos, &isInitialSelectionPending]( const bool isScanCompleted ) {
+            if ( !isInitialSelectionPending ) {
+                return;
             }
 
-            if ( it != lists.end() ) {
-                listbox.SetCurrent( std::distance( lists.begin(), it ) );
+            if ( lastfile.empty() ) {
+                if ( !lists.empty() ) {
+                    listbox.SetCurrent( 0 );
+                }
             }
             else {
-                if ( !isEditing ) {
-                    filename.clear();
-                    charInsertPos = 0;
+                const int lastFileId = findSaveFile( lists, lastfile );
+                if ( lastFileId >= 0 ) {
+                    listbox.SetCurrent( lastFileId );
+                    isInitialSelectionPending = false;
+                }
+                else {
+                    listbox.Unselect();
                 }
-                listbox.Unselect();
             }
-        }
 
-        if ( filename.empty() && listbox.isSelected() ) {
-            filename = System::GetStem( listbox.GetCurrent().filename );
-            charInsertPos = filename.size();
-        }
+            if ( listbox.isSelected() ) {
+                filename = System::GetStem( listbox.GetCurrent().filename );
+                charInsertPos = filename.size();
+            }
+
+            if ( isScanCompleted ) {
+                isInitialSelectionPending = false;
+            }
+        };
+
+        // New files are inserted into the sorted list while the selected file and the visible part of the list stay in place.
+        const auto addScannedSaveFiles = [&lists, &listbox, &scanner]() {
+            const std::string selectedFilePath = listbox.isSelected() ? listbox.GetCurrent().filename : std::string{};
+            const std::string topFilePath = listbox.IsValid() ? lists[listbox.getTopId()].filename : std::string{};
+
+            if ( !scanner.takeFileInfos( lists ) ) {
+                return false;
+            }
+
+            std::sort( lists.begin(), lists.end(), Maps::FileInfo::sortByFileName );
+
+            listbox.setTopVisibleItem( std::max( findSaveFile( lists, topFilePath ), 0 ) );
+
+            if ( !selectedFilePath.empty() ) {
+                listbox.SetCurrent( findSaveFile( lists, selectedFilePath ) );
+            }
+
+            listbox.updateScrollBarImage();
+
+            return true;
+        };
+
+        addScannedSaveFiles();
+        updateInitialSelection( false );
 
         auto buttonOkDisabler = [&buttonOk, &filename]() {
             if ( filename.empty() && buttonOk.isEnabled() ) {
@@ -394,9 +503,29 @@ namespace
 
         bool isCursorVisible = true;
 
+        bool isScanCompleted = false;
+
         LocalEvent & le = LocalEvent::Get();
 
         while ( le.HandleEvents( !isEditing || Game::isDelayNeeded( { Game::DelayType::CURSOR_BLINK_DELAY } ) ) && result.empty() ) {
+            bool isListUpdated = false;
+
+            if ( !isScanCompleted ) {
+                // The completion flag has to be checked before taking the files, otherwise the last files could be missed.
+                isScanCompleted = scanner.isCompleted();
+
+                if ( addScannedSaveFiles() || isScanCompleted ) {
+                    isListUpdated = true;
+
+                    updateInitialSelection( isScanCompleted );
+
+                    if ( !isEditing && !lists.empty() && buttonOk.isDisabled() ) {
+                        buttonOk.enable();
+                        buttonOk.draw();
+                    }
+                }
+            }
+
             buttonOk.drawOnState( le.isMouseLeftButtonPressedInArea( buttonOk.area() ) );
             buttonCancel.drawOnState( le.isMouseLeftButtonPressedInArea( buttonCancel.area() ) );
             if ( isEditing ) {
@@ -411,9 +540,13 @@ namespace
 
             const bool listboxEvent = listbox.QueueEventProcessing();
 
+            if ( listboxEvent ) {
+                isInitialSelectionPending = false;
+            }
+
             bool isListboxSelected = listbox.isSelected();
 
-            bool needRedraw = listId != listbox.getCurrentId();
+            bool needRedraw = isListUpdated || listId != listbox.getCurrentId();
 
             if ( le.isKeyPressed( fheroes2::Key::KEY_DELETE ) && isListboxSelected ) {
                 listbox.SetCurrent( listId );
@@ -425,7 +558,9 @@ namespace
 
                 if ( Dialog::YES == fheroes2::showStandardTextMessage( _( "Warning!" ), msg, Dialog::YES | Dialog::NO ) ) {
                     System::Unlink( listbox.GetCurrent().filename );
+                    Game::removeUnusedBaseTiles();
                     listbox.RemoveSelected();
+                    isInitialSelectionPending = false;
 
                     if ( lists.empty() ) {
                         listbox.Redraw();
@@ -459,6 +594,7 @@ namespace
 
                     charInsertPos = filename.size();
                     listbox.Unselect();
+                    isInitialSelectionPending = false;
                     isListboxSelected = false;
                     needRedraw = true;
 
@@ -474,6 +610,7 @@ namespace
                                                                           textInputRoi.x + textStartOffsetX );
 
                     listbox.Unselect();
+                    isInitialSelectionPending = false;
                     isListboxSelected = false;
                     needRedraw = true;
                 }
@@ -486,6 +623,7 @@ namespace
 
                     needRedraw = true;
                     listbox.Unselect();
+                    isInitialSelectionPending = false;
                     isListboxSelected = false;
                 }
             }
@@ -542,7 +680,7 @@ namespace
                 }
             }
 
-            if ( listbox.IsNeedRedraw() ) {
+            if ( isListUpdated || listbox.IsNeedRedraw() ) {
                 listbox.Redraw();
                 display.render( area );
             }
@@ -22,24 +22,134 @@
 
 #include <cassert>
 #include <cstdint>
+#include <utility>
+#include <vector>
 
 #include "map_format_helper.h"
 #include "map_format_info.h"
+#include "map_object_info.h"
+#include "maps_tiles.h"
+#include "world.h"
 #include "world_object_uid.h"
 
+namespace fheroes2
+{
+    // A copy of the map state after the most recent change. Every action compares the map against this state to find out
+    // what has been changed, so only the changed parts have to be stored by the action itself.
+    class MapSnapshot
+    {
+    public:
+        bool isValid() const
+        {
+            return _isValid;
+        }
+
+        void reset()
+        {
+            _mapTiles = {};
+            _mapData = {};
+            _worldTiles = {};
+
+            _isValid = false;
+        }
+
+        void capture( const Maps::Map_Format::MapFormat & map )
+        {
+            _mapTiles = map.tiles;
+            _mapData = Maps::Map_Format::saveMapDataWithoutTiles( map );
+
+            captureWorldTiles();
+
+            _isValid = true;
+        }
+
+        void captureWorldTiles()
+        {
+            const size_t tileCount = world.getSize();
+
+            _worldTiles.clear();
+            _worldTiles.reserve( tileCount );
+
+            for ( size_t i = 0; i < tileCount; ++i ) {
+                _worldTiles.push_back( world.GetTiles( static_cast<int32_t>( i ) ) );
+            }
+        }
+
+        bool isMatchingWorld() const
+        {
+            return _worldTiles.size() == world.getSize();
+        }
+
+        std::vector<Maps::Map_Format::TileInfo> & mapTiles()
+        {
+            return _mapTiles;
+        }
+
+        std::vector<uint8_t> & mapData()
+        {
+            return _mapData;
+        }
+
+        std::vector<Maps::Tiles> & worldTiles()
+        {
+            return _worldTiles;
+        }
+
+    private:
+        std::vector<Maps::Map_Format::TileInfo> _mapTiles;
+
+        // Map data except tiles in a serialized form.
+        std::vector<uint8_t> _mapData;
+
+        std::vector<Maps::Tiles> _worldTiles;
+
+        bool _isValid{ false };
+    };
+}
+
 namespace
 {
-    // This class holds 2 copies of MapFormat objects:
-    // - one copy before the action
-    // - one copy after the action
-    // Ideally, we need to store only difference between before and after an action
-    // but for simplification purposes we chose this way.
-    // TODO: optimize this class (if possible) to store less data.
+    // Towns and heroes are not a part of world tiles so changes related to them (including flags which define a town's color)
+    // cannot be applied to the world by replacing tiles only.
+    bool isFullReloadRequired( const Maps::Map_Format::TileInfo & tile )
+    {
+        for ( const auto & object : tile.objects ) {
+            if ( object.group == Maps::ObjectGroup::KINGDOM_TOWNS || object.group == Maps::ObjectGroup::KINGDOM_HEROES
+                 || object.group == Maps::ObjectGroup::LANDSCAPE_FLAGS ) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    size_t getMemoryUsage( const Maps::Map_Format::TileInfo & tile )
+    {
+        return tile.objects.capacity() * sizeof( Maps::Map_Format::TileObjectInfo );
+    }
+
+    size_t getMemoryUsage( const Maps::Tiles & tile )
+    {
+        // Addons are stored in lists so every one of them occupies some extra space.
+        const size_t addonCount = tile.getBottomLayerAddons().size() + tile.getTopLayerAddons().size();
+
+        return addonCount * ( sizeof( Maps::TilesAddon ) + 2 * sizeof( void * ) );
+    }
+
+    // This class stores only the parts of the map which have been changed by the action:
+    // - the map tiles (which are the source of the map data in the Editor) along with their state before and after the action
+    // - the map data except tiles (metadata of objects, map properties, events and so on) in a serialized form if it has been changed
+    // - the world tiles which have been changed by the action to avoid rebuilding the whole world on undo or redo
+    //
+    // Changes of the world tiles are collected when the action is finalized since the world can be updated from the map after the action
+    // has been committed. Actions involving towns, heroes or their flags still require the world to be fully rebuilt from the map
+    // so world tiles are not stored for them.
     class MapAction final : public fheroes2::Action
     {
     public:
-        explicit MapAction( Maps::Map_Format::MapFormat & mapFormat )
+        MapAction( Maps::Map_Format::MapFormat & mapFormat, fheroes2::MapSnapshot & snapshot )
             : _mapFormat( mapFormat )
+            , _snapshot( snapshot )
             , _latestObjectUIDBefore( Maps::getLastObjectUID() )
         {
             if ( !Maps::saveMapInEditor( _mapFormat ) ) {
@@ -47,7 +157,9 @@ namespace
                 assert( 0 );
             }
 
-            _beforeMapFormat = _mapFormat;
+            if ( !_snapshot.isValid() || _snapshot.mapTiles().size() != _mapFormat.tiles.size() || !_snapshot.isMatchingWorld() ) {
+                _snapshot.capture( _mapFormat );
+            }
         }
 
         bool prepare()
@@ -58,20 +170,142 @@ namespace
                 return false;
             }
 
-            _afterMapFormat = _mapFormat;
+            std::vector<Maps::Map_Format::TileInfo> & snapshotTiles = _snapshot.mapTiles();
+            if ( snapshotTiles.size() != _mapFormat.tiles.size() ) {
+                // The map size cannot be changed by an action.
+                assert( 0 );
+                return false;
+            }
+
+            for ( size_t i = 0; i < snapshotTiles.size(); ++i ) {
+                Maps::Map_Format::TileInfo & snapshotTile = snapshotTiles[i];
+                const Maps::Map_Format::TileInfo & tile = _mapFormat.tiles[i];
+
+                if ( snapshotTile == tile ) {
+                    continue;
+                }
+
+                if ( isFullReloadRequired( snapshotTile ) || isFullReloadRequired( tile ) ) {
+                    _isFullReloadRequired = true;
+                }
+
+                _mapTileChanges.push_back( { i, std::move( snapshotTile ), tile } );
+                snapshotTile = tile;
+            }
+
+            std::vector<uint8_t> mapData = Maps::Map_Format::saveMapDataWithoutTiles( _mapFormat );
+            if ( mapData != _snapshot.mapData() ) {
+                _mapDataBefore = std::move( _snapshot.mapData() );
+                _mapDataAfter = mapData;
+                _snapshot.mapData() = std::move( mapData );
+            }
 
             _latestObjectUIDAfter = Maps::getLastObjectUID();
 
             return true;
         }
 
-        bool redo() override
+        void finalize() override
         {
-            _mapFormat = _afterMapFormat;
-            if ( !Maps::readMapInEditor( _mapFormat ) ) {
-                // If this assertion blows up then something is really wrong with the Editor.
+            if ( _isFinalized ) {
+                return;
+            }
+
+            _isFinalized = true;
+
+            std::vector<Maps::Tiles> & snapshotTiles = _snapshot.worldTiles();
+            if ( !_snapshot.isMatchingWorld() ) {
+                // The world has been recreated with a different size. This should never happen within the same map.
                 assert( 0 );
-                return false;
+                _isFullReloadRequired = true;
+                _snapshot.captureWorldTiles();
+                return;
+            }
+
+            for ( size_t i = 0; i < snapshotTiles.size(); ++i ) {
+                const Maps::Tiles & tile = world.GetTiles( static_cast<int32_t>( i ) );
+                if ( snapshotTiles[i] == tile ) {
+                    continue;
+                }
+
+                if ( !_isFullReloadRequired ) {
+                    _worldTileChanges.push_back( { i, std::move( snapshotTiles[i] ), tile } );
+                }
+
+                snapshotTiles[i] = tile;
+            }
+        }
+
+        // Reverts all the changes made since the creation of this uncommitted action.
+        void cancel()
+        {
+            std::vector<Maps::Map_Format::TileInfo> & snapshotTiles = _snapshot.mapTiles();
+            if ( snapshotTiles.size() != _mapFormat.tiles.size() ) {
+                // The map size cannot be changed by an action.
+                assert( 0 );
+                return;
+            }
+
+            bool isFullReloadNeeded = false;
+
+            for ( size_t i = 0; i < snapshotTiles.size(); ++i ) {
+                Maps::Map_Format::TileInfo & tile = _mapFormat.tiles[i];
+                if ( snapshotTiles[i] == tile ) {
+                    continue;
+                }
+
+                if ( isFullReloadRequired( snapshotTiles[i] ) || isFullReloadRequired( tile ) ) {
+                    isFullReloadNeeded = true;
+                }
+
+                tile = snapshotTiles[i];
+            }
+
+            if ( Maps::Map_Format::saveMapDataWithoutTiles( _mapFormat ) != _snapshot.mapData() ) {
+                applyMapData( _snapshot.mapData() );
+            }
+
+            if ( isFullReloadNeeded ) {
+                reloadWorld();
+            }
+            else {
+                const std::vector<Maps::Tiles> & snapshotWorldTiles = _snapshot.worldTiles();
+                for ( size_t i = 0; i < snapshotWorldTiles.size(); ++i ) {
+                    Maps::Tiles & tile = world.GetTiles( static_cast<int32_t>( i ) );
+                    if ( tile != snapshotWorldTiles[i] ) {
+                        tile = snapshotWorldTiles[i];
+                        world.markTileForRadarUpdate( static_cast<int32_t>( i ) );
+                    }
+                }
+            }
+
+            Maps::setLastObjectUID( _latestObjectUIDBefore );
+        }
+
+        bool redo() override
+        {
+            assert( _isFinalized );
+
+            for ( const MapTileChange & change : _mapTileChanges ) {
+                _mapFormat.tiles[change.index] = change.after;
+                _snapshot.mapTiles()[change.index] = change.after;
+            }
+
+            if ( !_mapDataAfter.empty() ) {
+                applyMapData( _mapDataAfter );
+            }
+
+            if ( _isFullReloadRequired ) {
+                if ( !reloadWorld() ) {
+                    return false;
+                }
+            }
+            else {
+                for ( const WorldTileChange & change : _worldTileChanges ) {
+                    world.GetTiles( static_cast<int32_t>( change.index ) ) = change.after;
+                    world.markTileForRadarUpdate( static_cast<int32_t>( change.index ) );
+                    _snapshot.worldTiles()[change.index] = change.after;
+                }
             }
 
             Maps::setLastObjectUID( _latestObjectUIDAfter );
@@ -81,26 +315,106 @@ namespace
 
         bool undo() override
         {
-            _mapFormat = _beforeMapFormat;
+            finalize();
+
+            for ( const MapTileChange & change : _mapTileChanges ) {
+                _mapFormat.tiles[change.index] = change.before;
+                _snapshot.mapTiles()[change.index] = change.before;
+            }
+
+            if ( !_mapDataBefore.empty() ) {
+                applyMapData( _mapDataBefore );
+            }
+
+            if ( _isFullReloadRequired ) {
+                if ( !reloadWorld() ) {
+                    return false;
+                }
+            }
+            else {
+                for ( const WorldTileChange & change : _worldTileChanges ) {
+                    world.GetTiles( static_cast<int32_t>( change.index ) ) = change.before;
+                    world.markTileForRadarUpdate( static_cast<int32_t>( change.index ) );
+                    _snapshot.worldTiles()[change.index] = change.before;
+                }
+            }
+
+            Maps::setLastObjectUID( _latestObjectUIDBefore );
+
+            return true;
+        }
+
+        size_t getMemoryUsage() const override
+        {
+            size_t size = sizeof( MapAction ) + _mapDataBefore.capacity() + _mapDataAfter.capacity();
+
+            size += _mapTileChanges.capacity() * sizeof( MapTileChange );
+            for ( const MapTileChange & change : _mapTileChanges ) {
+                size += ::getMemoryUsage( change.before ) + ::getMemoryUsage( change.after );
+            }
+
+            size += _worldTileChanges.capacity() * sizeof( WorldTileChange );
+            for ( const WorldTileChange & change : _worldTileChanges ) {
+                size += ::getMemoryUsage( change.before ) + ::getMemoryUsage( change.after );
+            }
+
+            return size;
+        }
+
+    private:
+        struct MapTileChange
+        {
+            size_t index{ 0 };
+            Maps::Map_Format::TileInfo before;
+            Maps::Map_Format::TileInfo after;
+        };
+
+        struct WorldTileChange
+        {
+            size_t index{ 0 };
+            Maps::Tiles before;
+            Maps::Tiles after;
+        };
+
+        void applyMapData( const std::vector<uint8_t> & data )
+        {
+            if ( !Maps::Map_Format::loadMapDataWithoutTiles( data, _mapFormat ) ) {
+                // If this assertion blows up then something is really wrong with the Editor.
+                assert( 0 );
+            }
+
+            _snapshot.mapData() = data;
+        }
+
+        bool reloadWorld()
+        {
             if ( !Maps::readMapInEditor( _mapFormat ) ) {
                 // If this assertion blows up then something is really wrong with the Editor.
                 assert( 0 );
                 return false;
             }
 
-            Maps::setLastObjectUID( _latestObjectUIDBefore );
+            _snapshot.captureWorldTiles();
 
             return true;
         }
 
-    private:
         Maps::Map_Format::MapFormat & _mapFormat;
 
-        Maps::Map_Format::MapFormat _beforeMapFormat;
-        Maps::Map_Format::MapFormat _afterMapFormat;
+        fheroes2::MapSnapshot & _snapshot;
+
+        std::vector<MapTileChange> _mapTileChanges;
+        std::vector<WorldTileChange> _worldTileChanges;
+
+        // Map data except tiles in a serialized form. Both are empty if the data has not been changed.
+        std::vector<uint8_t> _mapDataBefore;
+        std::vector<uint8_t> _mapDataAfter;
 
         const uint32_t _latestObjectUIDBefore{ 0 };
         uint32_t _latestObjectUIDAfter{ 0 };
+
+        bool _isFullReloadRequired{ false };
+        bool _isFinalized{ false };
     };
 }
 
@@ -109,7 +423,19 @@ namespace fheroes2
     ActionCreator::ActionCreator( HistoryManager & manager, Maps::Map_Format::MapFormat & mapFormat )
         : _manager( manager )
     {
-        _action = std::make_unique<MapAction>( mapFormat );
+        // All the changes made by the previous action must be collected before the map is going to be changed again.
+        _manager.finalizeLastAction();
+
+        _action = std::make_unique<MapAction>( mapFormat, _manager.getSnapshot() );
+    }
+
+    ActionCreator::~ActionCreator()
+    {
+        auto * action = dynamic_cast<MapAction *>( _action.get() );
+        if ( action != nullptr ) {
+            // The action wasn't committed. Undo all the changes.
+            action->cancel();
+        }
     }
 
     void ActionCreator::commit()
@@ -125,4 +451,85 @@ namespace fheroes2
             _manager.add( std::move( _action ) );
         }
     }
+
+    HistoryManager::HistoryManager()
+        : _snapshot( std::make_unique<MapSnapshot>() )
+    {
+        // Do nothing.
+    }
+
+    HistoryManager::~HistoryManager() = default;
+
+    void HistoryManager::reset()
+    {
+        _actions.clear();
+        _snapshot->reset();
+        _lastActionId = 0;
+    }
+
+    void HistoryManager::add( std::unique_ptr<Action> action )
+    {
+        _actions.resize( _lastActionId );
+
+        _actions.push_back( std::move( action ) );
+
+        ++_lastActionId;
+
+        // The memory used by the new action is not known until it is finalized, but the limit might be exceeded already.
+        _removeOldActions();
+    }
+
+    bool HistoryManager::undo()
+    {
+        if ( _lastActionId == 0 ) {
+            // Nothing to do.
+            return false;
+        }
+
+        // The action collects its changes of the world tiles before it is undone.
+        finalizeLastAction();
+
+        --_lastActionId;
+        return _actions[_lastActionId]->undo();
+    }
+
+    bool HistoryManager::redo()
+    {
+        if ( _lastActionId == _actions.size() ) {
+            // Nothing to do.
+            return false;
+        }
+
+        const bool result = _actions[_lastActionId]->redo();
+        ++_lastActionId;
+
+        return result;
+    }
+
+    void HistoryManager::finalizeLastAction()
+    {
+        if ( _lastActionId == 0 ) {
+            return;
+        }
+
+        _actions[_lastActionId - 1]->finalize();
+
+        // The changes of the world tiles collected by the action are now counted as well.
+        _removeOldActions();
+    }
+
+    void HistoryManager::_removeOldActions()
+    {
+        size_t memoryUsage = 0;
+        for ( const auto & storedAction : _actions ) {
+            memoryUsage += storedAction->getMemoryUsage();
+        }
+
+        while ( memoryUsage > maxMemoryUsage && _lastActionId > 1 ) {
+            memoryUsage -= _actions.front()->getMemoryUsage();
+
+            --_lastActionId;
+            _actions.pop_front();
+        }
+    }
 }
@@ -20,12 +20,9 @@
 
 #pragma once
 
-#include <algorithm>
-#include <cassert>
 #include <cstddef>
 #include <deque>
 #include <memory>
-#include <utility>
 
 namespace Maps::Map_Format
 {
@@ -35,6 +32,7 @@ namespace Maps::Map_Format
 namespace fheroes2
 {
     class HistoryManager;
+    class MapSnapshot;
 
     class Action
     {
@@ -44,6 +42,15 @@ namespace fheroes2
         virtual bool redo() = 0;
 
         virtual bool undo() = 0;
+
+        // Completes the action once no further changes can belong to it. It is called before any other action is created or undone.
+        virtual void finalize()
+        {
+            // Do nothing.
+        }
+
+        // Returns the approximate amount of memory occupied by the action, in bytes.
+        virtual size_t getMemoryUsage() const = 0;
     };
 
     // Remember the map state and create an action if the map has changed.
@@ -52,13 +59,7 @@ namespace fheroes2
     public:
         explicit ActionCreator( HistoryManager & manager, Maps::Map_Format::MapFormat & mapFormat );
 
-        ~ActionCreator()
-        {
-            if ( _action ) {
-                // The action wasn't committed. Undo all the changes.
-                _action->undo();
-            }
-        }
+        ~ActionCreator();
 
         ActionCreator( const ActionCreator & ) = delete;
 
@@ -75,58 +76,42 @@ namespace fheroes2
     class HistoryManager
     {
     public:
-        void reset()
-        {
-            _actions.clear();
-            _lastActionId = 0;
-        }
+        HistoryManager();
+        HistoryManager( const HistoryManager & ) = delete;
 
-        void add( std::unique_ptr<Action> action )
-        {
-            _actions.resize( _lastActionId );
+        ~HistoryManager();
 
-            _actions.push_back( std::move( action ) );
+        HistoryManager & operator=( const HistoryManager & ) = delete;
 
-            ++_lastActionId;
+        void reset();
 
-            if ( _actions.size() > maxActions ) {
-                --_lastActionId;
-                _actions.pop_front();
-            }
+        void add( std::unique_ptr<Action> action );
 
-            assert( _actions.size() <= maxActions );
-        }
+        bool undo();
 
-        bool undo()
-        {
-            if ( _lastActionId == 0 ) {
-                // Nothing to do.
-                return false;
-            }
+        bool redo();
 
-            --_lastActionId;
-            return _actions[_lastActionId]->undo();
-        }
+        // Finalizes the most recently performed action. It must be called before the map is going to be changed by another action.
+        void finalizeLastAction();
 
-        bool redo()
+        // The last known state of the map which is used to find out what has been changed by an action.
+        MapSnapshot & getSnapshot()
         {
-            if ( _lastActionId == _actions.size() ) {
-                // Nothing to do.
-                return false;
-            }
-
-            const bool result = _actions[_lastActionId]->redo();
-            ++_lastActionId;
-
-            return result;
+            return *_snapshot;
         }
 
     private:
-        // We shouldn't store too many actions. It is extremely rare when there is a need to revert so many changes.
-        static const size_t maxActions{ 500 };
+        // Actions store only the changed parts of the map but there is still no need to keep them forever. It is extremely rare
+        // when there is a need to revert so many changes.
+        static const size_t maxMemoryUsage{ 32 * 1024 * 1024 };
+
+        // Removes the oldest actions until the memory limit is met. The most recently performed action is always kept.
+        void _removeOldActions();
 
         std::deque<std::unique_ptr<Action>> _actions;
 
+        std::unique_ptr<MapSnapshot> _snapshot;
+
         size_t _lastActionId{ 0 };
     };
 }
@@ -63,6 +63,7 @@
 #include "embedded_image.h"
 #include "exception.h"
 #include "game.h"
+#include "game_io.h"
 #include "game_logo.h"
 #include "game_video.h"
 #include "game_video_type.h"
@@ -333,6 +334,8 @@ int main( int argc, char ** argv )
         // init game data
         Game::Init();
 
+        const Game::AsyncSaveInitializer asyncSaveInitializer;
+
         conf.setGameLanguage( conf.getGameLanguage() );
 
         if ( conf.isShowIntro() ) {
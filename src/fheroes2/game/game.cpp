@@ -27,7 +27,6 @@
 #include <cassert>
 #include <cmath>
 #include <functional>
-#include <map>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -244,7 +243,7 @@ void Game::EnvironmentSoundMixer()
         center = { world.w() / 2, world.h() / 2 };
     }
 
-    std::map<M82::SoundType, std::vector<AudioManager::AudioLoopEffectInfo>> soundEffects;
+    std::vector<AudioManager::AudioLoopEffectInfo> soundEffects;
 
     const int32_t maxOffset = 3;
 
@@ -315,12 +314,10 @@ void Game::EnvironmentSoundMixer()
             }
         }
 
-        std::vector<AudioManager::AudioLoopEffectInfo> & effects = soundEffects[soundType];
-
         // If there is already a source of the same sound in this direction, then choose the one that is closer.
-        if ( std::find_if( effects.begin(), effects.end(),
-                           [distance, angle]( AudioManager::AudioLoopEffectInfo & info ) {
-                               if ( info.angle != angle ) {
+        if ( std::find_if( soundEffects.begin(), soundEffects.end(),
+                           [soundType, distance, angle]( AudioManager::AudioLoopEffectInfo & info ) {
+                               if ( info.soundType != soundType || info.angle != angle ) {
                                    return false;
                                }
 
@@ -328,12 +325,12 @@ void Game::EnvironmentSoundMixer()
 
                                return true;
                            } )
-             != effects.end() ) {
+             != soundEffects.end() ) {
             continue;
         }
 
         // Otherwise, use the current one for now.
-        effects.emplace_back( angle, distance );
+        soundEffects.emplace_back( soundType, angle, distance );
 
         --availableChannels;
         if ( availableChannels == 0 ) {
@@ -341,6 +338,8 @@ void Game::EnvironmentSoundMixer()
         }
     }
 
+    std::sort( soundEffects.begin(), soundEffects.end() );
+
     AudioManager::playLoopSoundsAsync( std::move( soundEffects ) );
 }
 
@@ -23,9 +23,11 @@
 
 #include "game_delays.h"
 
+#include <algorithm>
 #include <cassert>
 
 #include "gamedefs.h"
+#include "localevent.h"
 #include "settings.h"
 #include "timing.h"
 
@@ -139,11 +141,16 @@ void Game::AnimateResetDelay( const DelayType delayType )
 
 bool Game::validateCustomAnimationDelay( const uint64_t delayMs )
 {
-    if ( delays[Game::DelayType::CUSTOM_DELAY].isPassed( delayMs ) ) {
-        delays[Game::DelayType::CUSTOM_DELAY].reset();
+    fheroes2::TimeDelay & delay = delays[Game::DelayType::CUSTOM_DELAY];
+
+    const uint64_t remainingMs = delay.getRemainingMs( delayMs );
+    if ( remainingMs == 0 ) {
+        delay.reset();
+        LocalEvent::Get().limitNextIdleWaitTime( delayMs );
         return true;
     }
 
+    LocalEvent::Get().limitNextIdleWaitTime( remainingMs );
     return false;
 }
 
@@ -151,11 +158,18 @@ bool Game::validateAnimationDelay( const DelayType delayType )
 {
     assert( delayType != Game::DelayType::CUSTOM_DELAY );
 
-    if ( delays[delayType].isPassed() ) {
-        delays[delayType].reset();
+    fheroes2::TimeDelay & delay = delays[delayType];
+
+    // The animation is checked in a loop, so the next call of the event handler should not wait for new events longer than
+    // the time left until the next frame.
+    const uint64_t remainingMs = delay.getRemainingMs();
+    if ( remainingMs == 0 ) {
+        delay.reset();
+        LocalEvent::Get().limitNextIdleWaitTime( delay.getDelay() );
         return true;
     }
 
+    LocalEvent::Get().limitNextIdleWaitTime( remainingMs );
     return false;
 }
 
@@ -236,20 +250,35 @@ bool Game::hasEveryDelayPassed( const std::vector<Game::DelayType> & delayTypes
 
 bool Game::isDelayNeeded( const std::vector<Game::DelayType> & delayTypes )
 {
+    uint64_t remainingMs = UINT64_MAX;
+
     for ( const Game::DelayType type : delayTypes ) {
         assert( type != Game::DelayType::CUSTOM_DELAY );
 
-        if ( delays[type].isPassed() ) {
+        const uint64_t delayRemainingMs = delays[type].getRemainingMs();
+        if ( delayRemainingMs == 0 ) {
             return false;
         }
+
+        remainingMs = std::min( remainingMs, delayRemainingMs );
     }
 
+    // Nothing has to be animated until the nearest delay is passed so there is no need to process events more often unless they arrive.
+    LocalEvent::Get().limitNextIdleWaitTime( remainingMs );
+
     return true;
 }
 
 bool Game::isCustomDelayNeeded( const uint64_t delayMs )
 {
-    return !delays[Game::DelayType::CUSTOM_DELAY].isPassed( delayMs );
+    const uint64_t remainingMs = delays[Game::DelayType::CUSTOM_DELAY].getRemainingMs( delayMs );
+    if ( remainingMs == 0 ) {
+        return false;
+    }
+
+    LocalEvent::Get().limitNextIdleWaitTime( remainingMs );
+
+    return true;
 }
 
 uint64_t Game::getAnimationDelayValue( const DelayType delayType )
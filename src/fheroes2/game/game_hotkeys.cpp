@@ -263,6 +263,8 @@ namespace
 #if defined( WITH_DEBUG )
         hotKeyEventInfo[hotKeyEventToInt( Game::HotKeyEvent::WORLD_TRANSFER_CONTROL_TO_AI )]
             = { Game::HotKeyCategory::WORLD_MAP, gettext_noop( "hotkey|transfer control to ai" ), fheroes2::Key::KEY_F8 };
+        hotKeyEventInfo[hotKeyEventToInt( Game::HotKeyEvent::WORLD_REPLAY_BATTLE_RECORDS )]
+            = { Game::HotKeyCategory::WORLD_MAP, gettext_noop( "hotkey|replay battle records" ), fheroes2::Key::KEY_F9 };
 #endif
 
         hotKeyEventInfo[hotKeyEventToInt( Game::HotKeyEvent::BATTLE_RETREAT )]
@@ -132,6 +132,7 @@ namespace Game
 #if defined( WITH_DEBUG )
         // This hotkey is only for debug mode as of now.
         WORLD_TRANSFER_CONTROL_TO_AI,
+        WORLD_REPLAY_BATTLE_RECORDS,
 #endif
 
         BATTLE_RETREAT,
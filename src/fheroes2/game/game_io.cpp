@@ -24,15 +24,25 @@
 #include "game_io.h"
 
 #include <algorithm>
+#include <cassert>
 #include <cctype>
+#include <condition_variable>
 #include <cstdint>
 #include <ctime>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <ostream>
+#include <set>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "campaign_savedata.h"
 #include "campaign_scenariodata.h"
 #include "dialog.h"
+#include "dir.h"
 #include "game.h"
 #include "game_over.h"
 #include "logging.h"
@@ -41,10 +51,13 @@
 #include "serialize.h"
 #include "settings.h"
 #include "system.h"
+#include "thread.h"
+#include "timing.h"
 #include "translations.h"
 #include "ui_dialog.h"
 #include "ui_language.h"
 #include "world.h"
+#include "world_base_tiles.h"
 #include "zzlib.h"
 
 namespace
@@ -101,18 +114,639 @@ namespace
     {
         return stream >> hdr.status >> hdr.info >> hdr.gameType;
     }
+
+    // Headers of save files are memoized, so the file selection dialog doesn't have to read every save file each time it is opened.
+    // An entry is considered outdated once the size or the modification time of its file changes.
+    struct SaveFileInfoCacheEntry
+    {
+        uint64_t fileSize{ 0 };
+        int64_t modificationTime{ 0 };
+        // Not set if the file is not a valid save file
+        std::optional<HeaderSAV> header;
+    };
+
+    std::mutex saveFileInfoCacheMutex;
+
+    std::map<std::string, SaveFileInfoCacheEntry, std::less<>> saveFileInfoCache;
+
+    void forgetSaveFileInfo( const std::string & filePath )
+    {
+        const std::scoped_lock<std::mutex> lock( saveFileInfoCacheMutex );
+
+        saveFileInfoCache.erase( filePath );
+    }
+
+    bool readSaveFileHeader( StreamFile & fs, const std::string & filePath, HeaderSAV & header, uint16_t & saveFileVersion )
+    {
+        fs.setBigendian( true );
+
+        if ( !fs.open( filePath, "rb" ) ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << filePath )
+            return false;
+        }
+
+        uint16_t savId = 0;
+        fs >> savId;
+
+        if ( savId != SAV2ID3 ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "Invalid file identifier in the file " << filePath )
+            return false;
+        }
+
+        std::string saveFileVersionStr;
+
+        fs >> saveFileVersionStr >> saveFileVersion;
+
+        DEBUG_LOG( DBG_GAME, DBG_TRACE, "Version of the file " << filePath << ": " << saveFileVersion )
+
+        if ( saveFileVersion > CURRENT_FORMAT_VERSION || saveFileVersion < LAST_SUPPORTED_FORMAT_VERSION ) {
+            return false;
+        }
+
+        // The format of the header doesn't depend on the version of the save file
+        fs >> header;
+
+        return !fs.fail();
+    }
+
+    std::optional<HeaderSAV> readSaveFileHeader( const std::string & filePath )
+    {
+        StreamFile fs;
+        HeaderSAV header;
+        uint16_t saveFileVersion = 0;
+
+        if ( !readSaveFileHeader( fs, filePath, header, saveFileVersion ) ) {
+            return {};
+        }
+
+        return header;
+    }
+
+    // Returns the name of the file of the base tiles the save file refers to or an empty string if this is not a delta save
+    std::string getBaseTilesFileName( const std::string & filePath )
+    {
+        StreamFile fs;
+        HeaderSAV header;
+        uint16_t saveFileVersion = 0;
+
+        if ( !readSaveFileHeader( fs, filePath, header, saveFileVersion ) || saveFileVersion < FORMAT_VERSION_PRE1_1102_RELEASE ) {
+            return {};
+        }
+
+        bool isDeltaSave = false;
+        uint32_t baseTilesMapSeed = 0;
+        uint32_t baseTilesChecksum = 0;
+
+        fs >> isDeltaSave >> baseTilesMapSeed >> baseTilesChecksum;
+
+        if ( fs.fail() || !isDeltaSave ) {
+            return {};
+        }
+
+        return WorldBaseTiles::getFileName( baseTilesMapSeed, baseTilesChecksum );
+    }
+
+    // Returns the name of the file of the base tiles used by the current game or an empty string if they have not been stored
+    std::string getCurrentBaseTilesFileName()
+    {
+        const WorldBaseTiles & baseTiles = world.getBaseTiles();
+        if ( !baseTiles.isStored() ) {
+            return {};
+        }
+
+        return WorldBaseTiles::getFileName( baseTiles.getMapSeed(), baseTiles.getChecksum() );
+    }
+
+    // Returns false if there cannot be any unused files of the base tiles, so the save files don't have to be scanned
+    bool isBaseTilesCleanupNeeded()
+    {
+        return Settings::Get().isDeltaSaveEnabled() || WorldBaseTiles::hasStoredFiles();
+    }
+
+    // Removes the files of the base tiles which are not referred to by any save file. The base tiles of the current game are kept too,
+    // since the next save of this game is going to refer to them. Since the headers of all save files are read, it is done by the worker thread.
+    void removeUnusedBaseTilesFiles( const std::string & currentBaseTilesFileName )
+    {
+        std::set<std::string> usedFileNames;
+
+        if ( !currentBaseTilesFileName.empty() ) {
+            usedFileNames.insert( currentBaseTilesFileName );
+        }
+
+        ListFiles saveFiles;
+
+        for ( const int gameType : { Game::TYPE_STANDARD, Game::TYPE_CAMPAIGN, Game::TYPE_HOTSEAT, Game::TYPE_NETWORK } ) {
+            saveFiles.ReadDir( Game::GetSaveDir(), Game::GetSaveFileExtension( gameType ) );
+        }
+
+        for ( const std::string & saveFilePath : saveFiles ) {
+            std::string fileName = getBaseTilesFileName( saveFilePath );
+            if ( !fileName.empty() ) {
+                usedFileNames.insert( std::move( fileName ) );
+            }
+        }
+
+        WorldBaseTiles::removeUnusedFiles( usedFileNames );
+    }
+
+    bool writeSaveHeader( OStreamBase & stream )
+    {
+        const Settings & conf = Settings::Get();
+
+        // Always use the latest version of the file save format
+        Game::SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
+        const uint16_t saveFileVersion = CURRENT_FORMAT_VERSION;
+
+        stream << SAV2ID3 << std::to_string( saveFileVersion ) << saveFileVersion
+               << HeaderSAV( conf.getCurrentMapInfo(), conf.GameType(), world.GetDay(), world.GetWeek(), world.GetMonth() );
+
+        // A delta save refers to the base tiles which have to be loaded before the rest of the data
+        world.prepareDeltaSave();
+
+        const WorldBaseTiles & baseTiles = world.getBaseTiles();
+        const bool isDeltaSave = world.isDeltaSaveAvailable();
+
+        stream << isDeltaSave << ( isDeltaSave ? baseTiles.getMapSeed() : 0U ) << ( isDeltaSave ? baseTiles.getChecksum() : 0U );
+
+        return !stream.fail();
+    }
+
+    // Since FORMAT_VERSION_PRE2_1102_RELEASE the data following the header is split into sections which are compressed independently.
+    // The header is followed by the number of sections and a table containing the identifier and the offset from the beginning of the file
+    // of every section, so any section can be read without decompressing the others. Sections have to be read in the order of their
+    // identifiers to restore the game state.
+    enum class SaveFileSection : uint32_t
+    {
+        WORLD_TILES = 1,
+        WORLD_HEROES,
+        WORLD_CASTLES,
+        WORLD_KINGDOMS,
+        WORLD_STATE,
+        SETTINGS,
+        GAME_OVER_RESULT,
+        CAMPAIGN
+    };
+
+    // This is just a sanity check for corrupted files
+    const uint32_t maxSaveFileSectionCount = 64;
+
+    std::vector<SaveFileSection> getSaveFileSections()
+    {
+        std::vector<SaveFileSection> sections{ SaveFileSection::WORLD_TILES,    SaveFileSection::WORLD_HEROES, SaveFileSection::WORLD_CASTLES,
+                                               SaveFileSection::WORLD_KINGDOMS, SaveFileSection::WORLD_STATE,  SaveFileSection::SETTINGS,
+                                               SaveFileSection::GAME_OVER_RESULT };
+
+        if ( Settings::Get().isCampaignGameType() ) {
+            sections.push_back( SaveFileSection::CAMPAIGN );
+        }
+
+        return sections;
+    }
+
+    bool writeSaveSectionData( OStreamBase & stream, const SaveFileSection section )
+    {
+        switch ( section ) {
+        case SaveFileSection::WORLD_TILES:
+            world.writeSaveSection( stream, World::SaveSection::TILES );
+            break;
+        case SaveFileSection::WORLD_HEROES:
+            world.writeSaveSection( stream, World::SaveSection::HEROES );
+            break;
+        case SaveFileSection::WORLD_CASTLES:
+            world.writeSaveSection( stream, World::SaveSection::CASTLES );
+            break;
+        case SaveFileSection::WORLD_KINGDOMS:
+            world.writeSaveSection( stream, World::SaveSection::KINGDOMS );
+            break;
+        case SaveFileSection::WORLD_STATE:
+            world.writeSaveSection( stream, World::SaveSection::STATE );
+            break;
+        case SaveFileSection::SETTINGS:
+            stream << Settings::Get();
+            break;
+        case SaveFileSection::GAME_OVER_RESULT:
+            stream << GameOver::Result::Get();
+            break;
+        case SaveFileSection::CAMPAIGN:
+            stream << Campaign::CampaignSaveData::Get();
+            break;
+        default:
+            // Did you add a new section?
+            assert( 0 );
+            return false;
+        }
+
+        return !stream.fail();
+    }
+
+    bool readSaveSectionData( IStreamBase & stream, const SaveFileSection section )
+    {
+        switch ( section ) {
+        case SaveFileSection::WORLD_TILES:
+            return world.readSaveSection( stream, World::SaveSection::TILES );
+        case SaveFileSection::WORLD_HEROES:
+            return world.readSaveSection( stream, World::SaveSection::HEROES );
+        case SaveFileSection::WORLD_CASTLES:
+            return world.readSaveSection( stream, World::SaveSection::CASTLES );
+        case SaveFileSection::WORLD_KINGDOMS:
+            return world.readSaveSection( stream, World::SaveSection::KINGDOMS );
+        case SaveFileSection::WORLD_STATE:
+            if ( !world.readSaveSection( stream, World::SaveSection::STATE ) ) {
+                return false;
+            }
+
+            world.completeLoadingFromSave();
+            break;
+        case SaveFileSection::SETTINGS:
+            stream >> Settings::Get();
+            break;
+        case SaveFileSection::GAME_OVER_RESULT:
+            stream >> GameOver::Result::Get();
+            break;
+        case SaveFileSection::CAMPAIGN:
+            stream >> Campaign::CampaignSaveData::Get();
+            break;
+        default:
+            // Did you add a new section?
+            assert( 0 );
+            return false;
+        }
+
+        return !stream.fail();
+    }
+
+    void writeSaveSectionTable( StreamFile & fileStream, const std::vector<SaveFileSection> & sections, const std::vector<uint32_t> & offsets )
+    {
+        assert( sections.size() == offsets.size() );
+
+        fileStream << static_cast<uint32_t>( sections.size() );
+
+        for ( size_t i = 0; i < sections.size(); ++i ) {
+            fileStream << static_cast<uint32_t>( sections[i] ) << offsets[i];
+        }
+    }
+
+    // Writes the table of sections followed by all sections. The uncompressed data of every section is provided by 'writeSection'.
+    bool writeSaveSections( StreamFile & fileStream, const std::vector<SaveFileSection> & sections,
+                            const std::function<bool( OStreamBase &, const size_t )> & writeSection )
+    {
+        const size_t tablePos = fileStream.tell();
+
+        // The actual offsets are not known yet, the table is going to be rewritten once all sections are written
+        std::vector<uint32_t> offsets( sections.size(), 0 );
+        writeSaveSectionTable( fileStream, sections, offsets );
+
+        uint64_t rawSize = 0;
+        uint64_t zipSize = 0;
+
+        for ( size_t i = 0; i < sections.size(); ++i ) {
+            offsets[i] = static_cast<uint32_t>( fileStream.tell() );
+
+            // The data is compressed on the fly and written directly to the file without building the whole uncompressed and compressed
+            // contents in memory
+            Compression::ZipFileOStream sectionStream( fileStream );
+            sectionStream.setBigendian( true );
+
+            if ( !writeSection( sectionStream, i ) || !sectionStream.finalize() ) {
+                return false;
+            }
+
+            rawSize += sectionStream.rawSize();
+            zipSize += sectionStream.zipSize();
+        }
+
+        const size_t endPos = fileStream.tell();
+
+        fileStream.seek( tablePos );
+        writeSaveSectionTable( fileStream, sections, offsets );
+        fileStream.seek( endPos );
+
+        DEBUG_LOG( DBG_GAME, DBG_INFO, "Saved " << sections.size() << " sections of " << rawSize << " bytes of data compressed to " << zipSize << " bytes" )
+
+        return !fileStream.fail();
+    }
+
+    // Reads all sections of the save file of FORMAT_VERSION_PRE2_1102_RELEASE and newer versions
+    bool readSaveSections( StreamFile & fileStream )
+    {
+        uint32_t sectionCount = 0;
+        fileStream >> sectionCount;
+
+        if ( fileStream.fail() || sectionCount == 0 || sectionCount > maxSaveFileSectionCount ) {
+            return false;
+        }
+
+        const size_t fileSize = fileStream.size();
+
+        std::map<SaveFileSection, uint32_t> sectionOffsets;
+
+        for ( uint32_t i = 0; i < sectionCount; ++i ) {
+            uint32_t section = 0;
+            uint32_t offset = 0;
+
+            fileStream >> section >> offset;
+
+            if ( offset >= fileSize ) {
+                return false;
+            }
+
+            sectionOffsets.try_emplace( static_cast<SaveFileSection>( section ), offset );
+        }
+
+        if ( fileStream.fail() ) {
+            return false;
+        }
+
+        const auto readSection = [&fileStream, &sectionOffsets]( const SaveFileSection section ) {
+            const auto iter = sectionOffsets.find( section );
+            if ( iter == sectionOffsets.end() ) {
+                return false;
+            }
+
+            fileStream.seek( iter->second );
+
+            Compression::UnzipIStream sectionStream( fileStream );
+            sectionStream.setBigendian( true );
+
+            if ( sectionStream.fail() ) {
+                return false;
+            }
+
+            return readSaveSectionData( sectionStream, section );
+        };
+
+        for ( const SaveFileSection section :
+              { SaveFileSection::WORLD_TILES, SaveFileSection::WORLD_HEROES, SaveFileSection::WORLD_CASTLES, SaveFileSection::WORLD_KINGDOMS,
+                SaveFileSection::WORLD_STATE, SaveFileSection::SETTINGS, SaveFileSection::GAME_OVER_RESULT } ) {
+            if ( !readSection( section ) ) {
+                return false;
+            }
+        }
+
+        if ( Settings::Get().isCampaignGameType() && !readSection( SaveFileSection::CAMPAIGN ) ) {
+            return false;
+        }
+
+        return true;
+    }
+
+    // Reads the data of the save file of versions prior to FORMAT_VERSION_PRE2_1102_RELEASE which is stored as a single compressed chunk
+    bool readLegacySaveData( StreamFile & fileStream )
+    {
+        // The data is decompressed on the fly while it is being read
+        Compression::UnzipIStream dataStream( fileStream );
+        dataStream.setBigendian( true );
+
+        if ( !World::Get().readLegacySave( dataStream ) ) {
+            return false;
+        }
+
+        dataStream >> Settings::Get() >> GameOver::Result::Get();
+        if ( dataStream.fail() ) {
+            return false;
+        }
+
+        if ( Settings::Get().isCampaignGameType() ) {
+            dataStream >> Campaign::CampaignSaveData::Get();
+        }
+
+        uint16_t endOfDataMarker = 0;
+        dataStream >> endOfDataMarker;
+
+        return !dataStream.fail() && endOfDataMarker == SAV2ID3;
+    }
+
+    // Compression of the autosave data and writing it to the disk is done by the worker thread, so the player has to wait only
+    // for the in-memory snapshot of the game state. The worker thread also removes the files of the base tiles which are not used anymore.
+    class AsyncSaveManager final : public MultiThreading::AsyncManager
+    {
+    public:
+        void pushSave( std::string filePath, RWStreamBuf headerStream, std::vector<SaveFileSection> sections, std::vector<RWStreamBuf> sectionStreams,
+                       std::optional<std::string> baseTilesFileNameToKeep )
+        {
+            // Only one save can be in progress at a time. Otherwise, several snapshots of the game state could accumulate in memory
+            // on slow storage devices.
+            waitForCompletion();
+
+            createWorker();
+
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _saveTask.emplace( std::move( filePath ), std::move( headerStream ), std::move( sections ), std::move( sectionStreams ),
+                               std::move( baseTilesFileNameToKeep ) );
+
+            notifyWorker();
+        }
+
+        void pushBaseTilesCleanup( std::string baseTilesFileNameToKeep )
+        {
+            waitForCompletion();
+
+            createWorker();
+
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _saveTask.emplace( std::move( baseTilesFileNameToKeep ) );
+
+            notifyWorker();
+        }
+
+        void waitForCompletion()
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            if ( !_saveTask && !_isSaveInProgress ) {
+                return;
+            }
+
+            DEBUG_LOG( DBG_GAME, DBG_INFO, "Waiting for the previous save to complete" )
+
+            _completionNotification.wait( lock, [this] { return !_saveTask && !_isSaveInProgress; } );
+        }
+
+    private:
+        struct SaveTask
+        {
+            SaveTask() = default;
+
+            SaveTask( std::string path, RWStreamBuf header, std::vector<SaveFileSection> saveFileSections, std::vector<RWStreamBuf> saveFileSectionStreams,
+                      std::optional<std::string> baseTilesFileName )
+                : filePath( std::move( path ) )
+                , headerStream( std::move( header ) )
+                , sections( std::move( saveFileSections ) )
+                , sectionStreams( std::move( saveFileSectionStreams ) )
+                , baseTilesFileNameToKeep( std::move( baseTilesFileName ) )
+            {
+                // Do nothing.
+            }
+
+            // The task which only removes the unused base tiles
+            explicit SaveTask( std::string baseTilesFileName )
+                : baseTilesFileNameToKeep( std::move( baseTilesFileName ) )
+            {
+                // Do nothing.
+            }
+
+            // Empty if nothing has to be saved
+            std::string filePath;
+            RWStreamBuf headerStream;
+            std::vector<SaveFileSection> sections;
+            std::vector<RWStreamBuf> sectionStreams;
+            // Set if the base tiles some file referred to might not be needed anymore, e.g. if the save overwrites an existing file
+            std::optional<std::string> baseTilesFileNameToKeep;
+        };
+
+        std::optional<SaveTask> _saveTask;
+
+        SaveTask _currentSaveTask;
+
+        bool _isSaveInProgress{ false };
+
+        std::condition_variable _completionNotification;
+
+        // This method is called by the worker thread and is protected by _mutex
+        bool prepareTask() override
+        {
+            assert( _saveTask.has_value() );
+
+            _currentSaveTask = std::move( *_saveTask );
+            _saveTask.reset();
+
+            _isSaveInProgress = true;
+
+            return false;
+        }
+
+        // This method is called by the worker thread, but is not protected by _mutex
+        void executeTask() override
+        {
+            if ( _currentSaveTask.filePath.empty() || saveFile() ) {
+                if ( _currentSaveTask.baseTilesFileNameToKeep ) {
+                    removeUnusedBaseTilesFiles( *_currentSaveTask.baseTilesFileNameToKeep );
+                }
+            }
+
+            // Release the memory occupied by the snapshot
+            _currentSaveTask = {};
+
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                _isSaveInProgress = false;
+            }
+
+            _completionNotification.notify_all();
+        }
+
+        bool saveFile()
+        {
+            // The data is written to a temporary file first, which then replaces the target file. This way, the previous save
+            // remains intact if the game crashes or the write fails for some reason.
+            const std::string tempFilePath = _currentSaveTask.filePath + ".tmp";
+
+            if ( !writeFile( tempFilePath ) || !System::Rename( tempFilePath, _currentSaveTask.filePath ) ) {
+                ERROR_LOG( "Failed to save the file " << _currentSaveTask.filePath )
+
+                System::Unlink( tempFilePath );
+
+                return false;
+            }
+
+            forgetSaveFileInfo( _currentSaveTask.filePath );
+
+            DEBUG_LOG( DBG_GAME, DBG_INFO, "The file " << _currentSaveTask.filePath << " has been saved" )
+
+            return true;
+        }
+
+        bool writeFile( const std::string & filePath )
+        {
+            StreamFile fileStream;
+            fileStream.setBigendian( true );
+
+            if ( !fileStream.open( filePath, "wb" ) ) {
+                return false;
+            }
+
+            RWStreamBuf & headerStream = _currentSaveTask.headerStream;
+
+            fileStream.putRaw( headerStream.data(), headerStream.size() );
+            if ( fileStream.fail() ) {
+                return false;
+            }
+
+            return writeSaveSections( fileStream, _currentSaveTask.sections, [this]( OStreamBase & stream, const size_t sectionId ) {
+                RWStreamBuf & sectionStream = _currentSaveTask.sectionStreams[sectionId];
+                stream.putRaw( sectionStream.data(), sectionStream.size() );
+
+                return !stream.fail();
+            } );
+        }
+    };
+
+    AsyncSaveManager asyncSaveManager;
+}
+
+Game::AsyncSaveInitializer::~AsyncSaveInitializer()
+{
+    asyncSaveManager.waitForCompletion();
+    asyncSaveManager.stopWorker();
 }
 
 bool Game::AutoSave()
 {
-    return Game::Save( System::concatPath( GetSaveDir(), autoSaveName + GetSaveFileExtension() ), true );
+    const std::string filePath = System::concatPath( GetSaveDir(), autoSaveName + GetSaveFileExtension() );
+
+    DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
+
+    // The previous autosave may still remove unused base tiles, which must not happen once the base tiles of this save are stored
+    asyncSaveManager.waitForCompletion();
+
+    const fheroes2::Time timer;
+
+    RWStreamBuf headerStream;
+    headerStream.setBigendian( true );
+
+    if ( !writeSaveHeader( headerStream ) ) {
+        return false;
+    }
+
+    std::vector<SaveFileSection> sections = getSaveFileSections();
+    std::vector<RWStreamBuf> sectionStreams( sections.size() );
+
+    size_t dataSize = 0;
+
+    for ( size_t i = 0; i < sections.size(); ++i ) {
+        RWStreamBuf & sectionStream = sectionStreams[i];
+        sectionStream.setBigendian( true );
+
+        if ( !writeSaveSectionData( sectionStream, sections[i] ) ) {
+            return false;
+        }
+
+        dataSize += sectionStream.size();
+    }
+
+    DEBUG_LOG( DBG_GAME, DBG_INFO, "Made a snapshot of " << dataSize << " bytes of data in " << timer.getMs() << " ms" )
+
+    std::optional<std::string> baseTilesFileNameToKeep;
+    if ( System::IsFile( filePath ) && isBaseTilesCleanupNeeded() ) {
+        baseTilesFileNameToKeep = getCurrentBaseTilesFileName();
+    }
+
+    asyncSaveManager.pushSave( filePath, std::move( headerStream ), std::move( sections ), std::move( sectionStreams ), std::move( baseTilesFileNameToKeep ) );
+
+    return true;
 }
 
 bool Game::Save( const std::string & filePath, const bool autoSave /* = false */ )
 {
     DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
 
-    const Settings & conf = Settings::Get();
+    // The background autosave may still write to the same file
+    asyncSaveManager.waitForCompletion();
+
+    const bool isFileOverwritten = System::IsFile( filePath );
 
     StreamFile fileStream;
     fileStream.setBigendian( true );
@@ -122,33 +756,29 @@ bool Game::Save( const std::string & filePath, const bool autoSave /* = false */
         return false;
     }
 
-    // Always use the latest version of the file save format
-    SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
-    uint16_t saveFileVersion = CURRENT_FORMAT_VERSION;
-
-    // Header
-    fileStream << SAV2ID3 << std::to_string( saveFileVersion ) << saveFileVersion
-               << HeaderSAV( conf.getCurrentMapInfo(), conf.GameType(), world.GetDay(), world.GetWeek(), world.GetMonth() );
-    if ( fileStream.fail() ) {
+    if ( !writeSaveHeader( fileStream ) ) {
         return false;
     }
 
-    RWStreamBuf dataStream;
-    dataStream.setBigendian( true );
+    const fheroes2::Time timer;
+
+    const std::vector<SaveFileSection> sections = getSaveFileSections();
 
-    dataStream << World::Get() << Settings::Get() << GameOver::Result::Get();
-    if ( dataStream.fail() ) {
+    const auto writeSection = [&sections]( OStreamBase & stream, const size_t sectionId ) { return writeSaveSectionData( stream, sections[sectionId] ); };
+
+    if ( !writeSaveSections( fileStream, sections, writeSection ) ) {
         return false;
     }
 
-    if ( conf.isCampaignGameType() ) {
-        dataStream << Campaign::CampaignSaveData::Get();
-    }
+    forgetSaveFileInfo( filePath );
 
-    // End-of-data marker
-    dataStream << SAV2ID3;
-    if ( dataStream.fail() || !Compression::zipStreamBuf( dataStream, fileStream ) ) {
-        return false;
+    DEBUG_LOG( DBG_GAME, DBG_INFO, "Saved the game in " << timer.getMs() << " ms" )
+
+    if ( isFileOverwritten && isBaseTilesCleanupNeeded() ) {
+        // The save file is going to be read by the worker thread
+        fileStream.close();
+
+        asyncSaveManager.pushBaseTilesCleanup( getCurrentBaseTilesFileName() );
     }
 
     if ( !autoSave ) {
@@ -164,6 +794,9 @@ fheroes2::GameMode Game::Load( const std::string & filePath )
 
     const auto showGenericErrorMessage = []() { fheroes2::showStandardTextMessage( _( "Error" ), _( "The save file is corrupted." ), Dialog::OK ); };
 
+    // The file could be still being written by the background autosave
+    asyncSaveManager.waitForCompletion();
+
     StreamFile fileStream;
     fileStream.setBigendian( true );
 
@@ -225,12 +858,23 @@ fheroes2::GameMode Game::Load( const std::string & filePath )
         return fheroes2::GameMode::CANCEL;
     }
 
-    RWStreamBuf dataStream;
-    dataStream.setBigendian( true );
+    if ( saveFileVersion >= FORMAT_VERSION_PRE1_1102_RELEASE ) {
+        bool isDeltaSave = false;
+        uint32_t baseTilesMapSeed = 0;
+        uint32_t baseTilesChecksum = 0;
 
-    if ( !Compression::unzipStream( fileStream, dataStream ) ) {
-        showGenericErrorMessage();
-        return fheroes2::GameMode::CANCEL;
+        fileStream >> isDeltaSave >> baseTilesMapSeed >> baseTilesChecksum;
+
+        if ( fileStream.fail() ) {
+            showGenericErrorMessage();
+            return fheroes2::GameMode::CANCEL;
+        }
+
+        if ( isDeltaSave && !World::Get().loadBaseTiles( baseTilesMapSeed, baseTilesChecksum ) ) {
+            fheroes2::showStandardTextMessage( _( "Error" ), _( "The initial state of the map this save file refers to is missing or corrupted." ), Dialog::OK );
+
+            return fheroes2::GameMode::CANCEL;
+        }
     }
 
     if ( ( header.status & HeaderSAV::REQUIRES_POL_RESOURCES ) && !conf.isPriceOfLoyaltySupported() ) {
@@ -241,17 +885,20 @@ fheroes2::GameMode Game::Load( const std::string & filePath )
         return fheroes2::GameMode::CANCEL;
     }
 
-    dataStream >> World::Get() >> conf >> GameOver::Result::Get();
-    if ( dataStream.fail() ) {
+    const fheroes2::Time timer;
+
+    const bool isDataRead = ( saveFileVersion >= FORMAT_VERSION_PRE2_1102_RELEASE ) ? readSaveSections( fileStream ) : readLegacySaveData( fileStream );
+    if ( !isDataRead ) {
         showGenericErrorMessage();
         return fheroes2::GameMode::CANCEL;
     }
 
+    DEBUG_LOG( DBG_GAME, DBG_INFO, "Loaded the game in " << timer.getMs() << " ms" )
+
     fheroes2::GameMode returnValue = fheroes2::GameMode::START_GAME;
 
     if ( conf.isCampaignGameType() ) {
-        Campaign::CampaignSaveData & saveData = Campaign::CampaignSaveData::Get();
-        dataStream >> saveData;
+        const Campaign::CampaignSaveData & saveData = Campaign::CampaignSaveData::Get();
 
         if ( !saveData.isStarting() && saveData.getCurrentScenarioInfoId() == saveData.getLastCompletedScenarioInfoID() ) {
             // This is the end of the current scenario. We should show next scenario selection.
@@ -259,13 +906,6 @@ fheroes2::GameMode Game::Load( const std::string & filePath )
         }
     }
 
-    uint16_t endOfDataMarker = 0;
-    dataStream >> endOfDataMarker;
-    if ( dataStream.fail() || endOfDataMarker != SAV2ID3 ) {
-        showGenericErrorMessage();
-        return fheroes2::GameMode::CANCEL;
-    }
-
     // Settings should contain the full path to the current map file, if this map is available
     conf.getCurrentMapInfo().filename = Settings::GetLastFile( "maps", System::GetBasename( conf.getCurrentMapInfo().filename ) );
 
@@ -289,52 +929,56 @@ bool Game::LoadSAV2FileInfo( std::string filePath, Maps::FileInfo & fileInfo )
 {
     DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
 
-    StreamFile fs;
-    fs.setBigendian( true );
-
-    if ( !fs.open( filePath, "rb" ) ) {
-        DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << filePath )
-        return false;
-    }
+    // The file could be still being written by the background autosave
+    asyncSaveManager.waitForCompletion();
 
-    uint16_t savId = 0;
-    fs >> savId;
+    uint64_t fileSize = 0;
+    int64_t modificationTime = 0;
 
-    if ( savId != SAV2ID3 ) {
-        DEBUG_LOG( DBG_GAME, DBG_WARN, "Invalid file identifier in the file " << filePath )
+    if ( !System::getFileSizeAndModificationTime( filePath, fileSize, modificationTime ) ) {
+        DEBUG_LOG( DBG_GAME, DBG_WARN, "Error accessing the file " << filePath )
         return false;
     }
 
-    std::string saveFileVersionStr;
-    uint16_t saveFileVersion = 0;
+    std::optional<HeaderSAV> header;
+    bool isCached = false;
 
-    fs >> saveFileVersionStr >> saveFileVersion;
-
-    DEBUG_LOG( DBG_GAME, DBG_TRACE, "Version of the file " << filePath << ": " << saveFileVersion )
+    {
+        const std::scoped_lock<std::mutex> lock( saveFileInfoCacheMutex );
 
-    if ( saveFileVersion > CURRENT_FORMAT_VERSION || saveFileVersion < LAST_SUPPORTED_FORMAT_VERSION ) {
-        return false;
+        const auto iter = saveFileInfoCache.find( filePath );
+        if ( iter != saveFileInfoCache.end() && iter->second.fileSize == fileSize && iter->second.modificationTime == modificationTime ) {
+            header = iter->second.header;
+            isCached = true;
+        }
     }
 
-    SetVersionOfCurrentSaveFile( saveFileVersion );
+    if ( !isCached ) {
+        // This function can be called from several threads at once, so the file is read without holding the lock
+        header = readSaveFileHeader( filePath );
 
-    HeaderSAV header;
-    fs >> header;
+        const std::scoped_lock<std::mutex> lock( saveFileInfoCacheMutex );
 
-    if ( fs.fail() ) {
-        return false;
+        saveFileInfoCache[filePath] = { fileSize, modificationTime, header };
     }
 
-    if ( ( Settings::Get().GameType() & header.gameType ) == 0 ) {
+    if ( !header || ( Settings::Get().GameType() & header->gameType ) == 0 ) {
         return false;
     }
 
-    fileInfo = std::move( header.info );
+    fileInfo = std::move( header->info );
     fileInfo.filename = std::move( filePath );
 
     return true;
 }
 
+void Game::removeUnusedBaseTiles()
+{
+    if ( isBaseTilesCleanupNeeded() ) {
+        asyncSaveManager.pushBaseTilesCleanup( getCurrentBaseTilesFileName() );
+    }
+}
+
 void Game::SetVersionOfCurrentSaveFile( const uint16_t version )
 {
     versionOfCurrentSaveFile = version;
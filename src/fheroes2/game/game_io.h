@@ -36,6 +36,19 @@ namespace Maps
 
 namespace Game
 {
+    // Autosaves are written to the disk by a worker thread. This class waits for the last autosave to complete and stops the
+    // worker thread on destruction, so its instance should exist as long as the game can be saved.
+    class AsyncSaveInitializer
+    {
+    public:
+        AsyncSaveInitializer() = default;
+        AsyncSaveInitializer( const AsyncSaveInitializer & ) = delete;
+
+        ~AsyncSaveInitializer();
+
+        AsyncSaveInitializer & operator=( const AsyncSaveInitializer & ) = delete;
+    };
+
     const std::string & GetLastSaveName();
     void SetLastSaveName( const std::string & name );
 
@@ -55,6 +68,9 @@ namespace Game
 
     bool LoadSAV2FileInfo( std::string filePath, Maps::FileInfo & fileInfo );
 
+    // Removes the stored initial states of maps which are not referred to by any save file. Should be called after a save file is deleted.
+    void removeUnusedBaseTiles();
+
     bool SaveCompletedCampaignScenario();
 }
 
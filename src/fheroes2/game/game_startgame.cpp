@@ -39,6 +39,7 @@
 #include "audio.h"
 #include "audio_manager.h"
 #include "battle_only.h"
+#include "battle_record.h"
 #include "castle.h"
 #include "color.h"
 #include "cursor.h"
@@ -1077,6 +1078,18 @@ fheroes2::GameMode Interface::AdventureMap::HumanTurn( const bool isload )
                 res = EventDigArtifact();
             else if ( HotKeyPressEvent( Game::HotKeyEvent::WORLD_SLEEP_HERO ) )
                 EventSwitchHeroSleeping();
+#if defined( WITH_DEBUG )
+            else if ( HotKeyPressEvent( Game::HotKeyEvent::WORLD_REPLAY_BATTLE_RECORDS ) ) {
+                size_t desyncCount = 0;
+                const size_t replayedCount = Battle::replayBattleRecords( desyncCount );
+
+                std::string msg( _( "Battle records replayed: %{count}, desyncs: %{desyncs}. See the log for details." ) );
+                StringReplace( msg, "%{count}", replayedCount );
+                StringReplace( msg, "%{desyncs}", desyncCount );
+
+                fheroes2::showStandardTextMessage( _( "Battle Records" ), std::move( msg ), Dialog::OK );
+            }
+#endif
             // hero movement control
             else if ( HotKeyPressEvent( Game::HotKeyEvent::WORLD_LEFT ) )
                 EventKeyArrowPress( Direction::LEFT );
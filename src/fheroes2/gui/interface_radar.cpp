@@ -139,6 +139,102 @@ namespace
 
         return false;
     }
+
+    struct RevealOptions
+    {
+        explicit RevealOptions( const ViewWorldMode flags )
+#ifdef WITH_DEBUG
+            : all( ( flags == ViewWorldMode::ViewAll ) || IS_DEVEL() )
+#else
+            : all( flags == ViewWorldMode::ViewAll )
+#endif
+            , mines( all || ( flags == ViewWorldMode::ViewMines ) )
+            , heroes( all || ( flags == ViewWorldMode::ViewHeroes ) )
+            , towns( all || ( flags == ViewWorldMode::ViewTowns ) )
+            , artifacts( all || ( flags == ViewWorldMode::ViewArtifacts ) )
+            , resources( all || ( flags == ViewWorldMode::ViewResources ) )
+            , onlyVisible( all || ( flags == ViewWorldMode::OnlyVisible ) )
+        {}
+
+        const bool all;
+        const bool mines;
+        const bool heroes;
+        const bool towns;
+        const bool artifacts;
+        const bool resources;
+        const bool onlyVisible;
+    };
+
+    // Returns the color of the tile on the radar. Tiles which are not revealed are black.
+    uint8_t getTileColor( const Maps::Tiles & tile, const fheroes2::Point & position, const int32_t playerColor, const RevealOptions & reveal )
+    {
+        const bool visibleTile = reveal.all || !tile.isFog( playerColor );
+
+        const MP2::MapObjectType objectType = tile.GetObject( reveal.onlyVisible || reveal.heroes );
+        switch ( objectType ) {
+        case MP2::OBJ_HERO: {
+            if ( visibleTile || reveal.heroes ) {
+                const Heroes * hero = world.GetHeroes( position );
+                if ( hero ) {
+                    return GetPaletteIndexFromColor( hero->GetColor() );
+                }
+            }
+            return COLOR_BLACK;
+        }
+        case MP2::OBJ_LIGHTHOUSE:
+        case MP2::OBJ_ALCHEMIST_LAB:
+        case MP2::OBJ_MINE:
+        case MP2::OBJ_SAWMILL:
+            // TODO: Why Lighthouse is in this category? Verify the logic!
+            if ( visibleTile || reveal.mines ) {
+                return GetPaletteIndexFromColor( world.ColorCapturedObject( tile.GetIndex() ) );
+            }
+            return COLOR_BLACK;
+        case MP2::OBJ_NON_ACTION_LIGHTHOUSE:
+        case MP2::OBJ_NON_ACTION_ALCHEMIST_LAB:
+        case MP2::OBJ_NON_ACTION_MINE:
+        case MP2::OBJ_NON_ACTION_SAWMILL:
+            // TODO: Why Lighthouse is in this category? Verify the logic!
+            if ( visibleTile || reveal.mines ) {
+                const int32_t mainTileIndex = Maps::Tiles::getIndexOfMainTile( tile );
+                if ( mainTileIndex >= 0 ) {
+                    return GetPaletteIndexFromColor( world.ColorCapturedObject( mainTileIndex ) );
+                }
+            }
+            return COLOR_BLACK;
+        case MP2::OBJ_ARTIFACT:
+            return ( visibleTile || reveal.artifacts ) ? COLOR_GRAY : COLOR_BLACK;
+        case MP2::OBJ_RESOURCE:
+            return ( visibleTile || reveal.resources ) ? COLOR_GRAY : COLOR_BLACK;
+        default:
+            break;
+        }
+
+        uint8_t fillColor = COLOR_BLACK;
+
+        if ( visibleTile ) {
+            // Castles and Towns can be partially covered by other non-action objects so we need to rely on special storage of castle's tiles.
+            if ( getCastleColor( fillColor, position ) ) {
+                return fillColor;
+            }
+
+            // This is a visible tile and not covered by other objects, so fill it with the ground tile data.
+            if ( tile.isRoad() ) {
+                return COLOR_ROAD;
+            }
+
+            fillColor = GetPaletteIndexFromGround( tile.GetGround() );
+
+            if ( objectType == MP2::OBJ_MOUNTAINS || objectType == MP2::OBJ_TREES ) {
+                fillColor += 3;
+            }
+        }
+        else if ( reveal.towns ) {
+            getCastleColor( fillColor, position );
+        }
+
+        return fillColor;
+    }
 }
 
 Interface::Radar::Radar( BaseInterface & interface )
@@ -155,7 +251,6 @@ Interface::Radar::Radar( const Radar & radar, const fheroes2::Display & display
     : BorderWindow( { display.width() - BORDERWIDTH - RADARWIDTH, BORDERWIDTH, RADARWIDTH, RADARWIDTH } )
     , _radarType( RadarType::ViewWorld )
     , _interface( radar._interface )
-    , _roi( 0, 0, world.w(), world.h() )
     , _zoom( radar._zoom )
     , _hide( false )
 {
@@ -180,7 +275,9 @@ void Interface::Radar::SetPos( int32_t ox, int32_t oy )
 void Interface::Radar::Build()
 {
     SetZoom();
-    _roi = { 0, 0, world.w(), world.h() };
+
+    _tilesToRedraw.clear();
+    _isFullRedrawNeeded = true;
 }
 
 void Interface::Radar::SetZoom()
@@ -207,10 +304,19 @@ void Interface::Radar::SetRedraw( const uint32_t redrawMode ) const
 void Interface::Radar::SetRenderArea( const fheroes2::Rect & roi )
 {
     const Settings & conf = Settings::Get();
-    // We set ROI only if radar is visible as there will be no render of radar map image if it is hidden.
-    if ( !conf.isHideInterfaceEnabled() || conf.ShowRadar() ) {
-        // "_roi" should not be outside the "world".
-        _roi = roi ^ fheroes2::Rect( 0, 0, world.w(), world.h() );
+    // We add tiles only if radar is visible as there will be no render of radar map image if it is hidden.
+    if ( _isFullRedrawNeeded || ( conf.isHideInterfaceEnabled() && !conf.ShowRadar() ) ) {
+        return;
+    }
+
+    // The area should not be outside the "world".
+    const int32_t worldWidth = world.w();
+    const fheroes2::Rect tilesRoi = roi ^ fheroes2::Rect( 0, 0, worldWidth, world.h() );
+
+    for ( int32_t y = tilesRoi.y; y < tilesRoi.y + tilesRoi.height; ++y ) {
+        for ( int32_t x = tilesRoi.x; x < tilesRoi.x + tilesRoi.width; ++x ) {
+            _tilesToRedraw.insert( y * worldWidth + x );
+        }
     }
 }
 
@@ -224,8 +330,8 @@ void Interface::Radar::_redraw( const bool redrawMapObjects )
         else {
             // We are in "Hide Interface" mode and radar is turned off so we have nothing to render.
 
-            // Force set radar ROI for the whole world to be prepared to fully update radar when it will be shown.
-            _roi = { 0, 0, world.w(), world.h() };
+            // Force the full update of the radar to be prepared to render it when it will be shown.
+            _isFullRedrawNeeded = true;
             return;
         }
     }
@@ -235,8 +341,8 @@ void Interface::Radar::_redraw( const bool redrawMapObjects )
     if ( _hide ) {
         fheroes2::Blit( fheroes2::AGG::GetICN( ( conf.isEvilInterfaceEnabled() ? ICN::HEROLOGE : ICN::HEROLOGO ), 0 ), display, rect.x, rect.y );
 
-        // Force set radar ROI for the whole world to be prepared to fully update radar when it will be shown.
-        _roi = { 0, 0, world.w(), world.h() };
+        // Force the full update of the radar to be prepared to render it when it will be shown.
+        _isFullRedrawNeeded = true;
     }
     else {
         _cursorArea.hide();
@@ -284,140 +390,75 @@ void Interface::Radar::redrawForEditor( const bool renderMapObjects )
 
 void Interface::Radar::RedrawObjects( const int32_t playerColor, const ViewWorldMode flags )
 {
-#ifdef WITH_DEBUG
-    const bool revealAll = ( flags == ViewWorldMode::ViewAll ) || IS_DEVEL();
-#else
-    const bool revealAll = flags == ViewWorldMode::ViewAll;
-#endif
-
-    uint8_t * radarImage = _map.image();
-
-    assert( _roi.x >= 0 && _roi.y >= 0 && ( _roi.width + _roi.x ) <= world.w() && ( _roi.height + _roi.y ) <= world.h() );
-
-    // Fill the radar map with black color ( 0 ) only if we are redrawing the entire map.
-    if ( _roi.x == 0 && _roi.y == 0 && _roi.width == world.w() && _roi.height == world.h() ) {
-        std::memset( radarImage, COLOR_BLACK, static_cast<size_t>( area.width ) * area.height );
+    if ( _radarType == RadarType::WorldMap ) {
+        // Only the tiles changed since the previous update are rendered.
+        if ( !world.takeTilesForRadarUpdate( _tilesToRedraw ) ) {
+            _isFullRedrawNeeded = true;
+        }
+    }
+    else {
+        // The View World radar is rendered once per view mode so it does not take the world changes intended for the main radar.
+        _isFullRedrawNeeded = true;
     }
 
-    const bool revealMines = revealAll || ( flags == ViewWorldMode::ViewMines );
-    const bool revealHeroes = revealAll || ( flags == ViewWorldMode::ViewHeroes );
-    const bool revealTowns = revealAll || ( flags == ViewWorldMode::ViewTowns );
-    const bool revealArtifacts = revealAll || ( flags == ViewWorldMode::ViewArtifacts );
-    const bool revealResources = revealAll || ( flags == ViewWorldMode::ViewResources );
-    const bool revealOnlyVisible = revealAll || ( flags == ViewWorldMode::OnlyVisible );
-
-    const int32_t radarWidth = _map.width();
+    if ( playerColor != _renderedPlayerColor || flags != _renderedMode ) {
+        _renderedPlayerColor = playerColor;
+        _renderedMode = flags;
+        _isFullRedrawNeeded = true;
+    }
 
-    const bool isZoomIn = _zoom > 1.0;
+    const RevealOptions reveal( flags );
 
-    const int32_t maxRoiX = _roi.width + _roi.x;
-    const int32_t maxRoiY = _roi.height + _roi.y;
+    if ( _isFullRedrawNeeded ) {
+        std::memset( _map.image(), COLOR_BLACK, static_cast<size_t>( area.width ) * area.height );
 
-    const uint8_t * radarYEnd = nullptr;
+        const int32_t worldWidth = world.w();
+        const int32_t worldHeight = world.h();
 
-    for ( int32_t y = _roi.y; y < maxRoiY; ++y ) {
-        uint8_t * radarY = radarImage + static_cast<size_t>( y * _zoom ) * radarWidth;
-        if ( isZoomIn ) {
-            radarYEnd = radarImage + static_cast<size_t>( ( y + 1 ) * _zoom ) * radarWidth;
-        }
+        for ( int32_t y = 0; y < worldHeight; ++y ) {
+            for ( int32_t x = 0; x < worldWidth; ++x ) {
+                const uint8_t fillColor = getTileColor( world.GetTiles( x, y ), { x, y }, playerColor, reveal );
 
-        for ( int32_t x = _roi.x; x < maxRoiX; ++x ) {
-            const Maps::Tiles & tile = world.GetTiles( x, y );
-            const bool visibleTile = revealAll || !tile.isFog( playerColor );
-
-            uint8_t fillColor = 0;
-
-            const MP2::MapObjectType objectType = tile.GetObject( revealOnlyVisible || revealHeroes );
-            switch ( objectType ) {
-            case MP2::OBJ_HERO: {
-                if ( visibleTile || revealHeroes ) {
-                    const Heroes * hero = world.GetHeroes( { x, y } );
-                    if ( hero ) {
-                        fillColor = GetPaletteIndexFromColor( hero->GetColor() );
-                        break;
-                    }
+                // The radar map image has already been filled with black color.
+                if ( fillColor != COLOR_BLACK ) {
+                    fillTile( x, y, fillColor );
                 }
-                continue;
             }
-            case MP2::OBJ_LIGHTHOUSE:
-            case MP2::OBJ_ALCHEMIST_LAB:
-            case MP2::OBJ_MINE:
-            case MP2::OBJ_SAWMILL:
-                // TODO: Why Lighthouse is in this category? Verify the logic!
-                if ( visibleTile || revealMines ) {
-                    fillColor = GetPaletteIndexFromColor( world.ColorCapturedObject( tile.GetIndex() ) );
-                    break;
-                }
-                continue;
-            case MP2::OBJ_NON_ACTION_LIGHTHOUSE:
-            case MP2::OBJ_NON_ACTION_ALCHEMIST_LAB:
-            case MP2::OBJ_NON_ACTION_MINE:
-            case MP2::OBJ_NON_ACTION_SAWMILL:
-                // TODO: Why Lighthouse is in this category? Verify the logic!
-                if ( visibleTile || revealMines ) {
-                    const int32_t mainTileIndex = Maps::Tiles::getIndexOfMainTile( tile );
-                    if ( mainTileIndex >= 0 ) {
-                        fillColor = GetPaletteIndexFromColor( world.ColorCapturedObject( mainTileIndex ) );
-                        break;
-                    }
-                }
-                continue;
-            case MP2::OBJ_ARTIFACT:
-                if ( visibleTile || revealArtifacts ) {
-                    fillColor = COLOR_GRAY;
-                    break;
-                }
-                continue;
-            case MP2::OBJ_RESOURCE:
-                if ( visibleTile || revealResources ) {
-                    fillColor = COLOR_GRAY;
-                    break;
-                }
+        }
+    }
+    else {
+        for ( const int32_t tileIndex : _tilesToRedraw ) {
+            if ( !Maps::isValidAbsIndex( tileIndex ) ) {
                 continue;
-            default:
-                if ( visibleTile ) {
-                    // Castles and Towns can be partially covered by other non-action objects so we need to rely on special storage of castle's tiles.
-                    if ( !getCastleColor( fillColor, { x, y } ) ) {
-                        // This is a visible tile and not covered by other objects, so fill it with the ground tile data.
-                        if ( tile.isRoad() ) {
-                            fillColor = COLOR_ROAD;
-                        }
-                        else {
-                            fillColor = GetPaletteIndexFromGround( tile.GetGround() );
-
-                            if ( objectType == MP2::OBJ_MOUNTAINS || objectType == MP2::OBJ_TREES ) {
-                                fillColor += 3;
-                            }
-                        }
-                    }
-                }
-                else if ( revealTowns ) {
-                    getCastleColor( fillColor, { x, y } );
-                }
-                else {
-                    // Non visible tile, we have already black radar so skip the render of this tile.
-                    continue;
-                }
             }
 
-            const size_t offsetX = static_cast<size_t>( x * _zoom );
-            uint8_t * radarX = radarY + offsetX;
-            if ( isZoomIn ) {
-                const uint8_t * radarXEnd = radarYEnd + offsetX;
-                const size_t radarXStep = static_cast<size_t>( ( x + 1 ) * _zoom ) - offsetX;
-
-                for ( ; radarX != radarXEnd; radarX += radarWidth ) {
-                    std::memset( radarX, fillColor, radarXStep );
-                }
-            }
-            else {
-                *radarX = fillColor;
-            }
+            const fheroes2::Point position = Maps::GetPoint( tileIndex );
+            fillTile( position.x, position.y, getTileColor( world.GetTiles( tileIndex ), position, playerColor, reveal ) );
         }
     }
 
-    // Reset ROI to full radar image to be able to redraw the mini-map without calling 'SetMapRedraw()'.
-    _roi = { 0, 0, world.w(), world.h() };
+    _tilesToRedraw.clear();
+    _isFullRedrawNeeded = false;
+}
+
+void Interface::Radar::fillTile( const int32_t x, const int32_t y, const uint8_t fillColor )
+{
+    const int32_t radarWidth = _map.width();
+    const size_t offsetX = static_cast<size_t>( x * _zoom );
+
+    uint8_t * radarX = _map.image() + static_cast<size_t>( y * _zoom ) * radarWidth + offsetX;
+
+    if ( _zoom > 1.0 ) {
+        const uint8_t * radarXEnd = _map.image() + static_cast<size_t>( ( y + 1 ) * _zoom ) * radarWidth + offsetX;
+        const size_t radarXStep = static_cast<size_t>( ( x + 1 ) * _zoom ) - offsetX;
+
+        for ( ; radarX != radarXEnd; radarX += radarWidth ) {
+            std::memset( radarX, fillColor, radarXStep );
+        }
+    }
+    else {
+        *radarX = fillColor;
+    }
 }
 
 // Redraw radar cursor. RoiRectangle is a rectangle in tile unit of the current radar view.
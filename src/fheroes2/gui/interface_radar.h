@@ -25,6 +25,7 @@
 #define H2INTERFACE_RADAR_H
 
 #include <cstdint>
+#include <set>
 
 #include "image.h"
 #include "interface_border.h"
@@ -61,7 +62,8 @@ namespace Interface
         // - 'REDRAW_RADAR_CURSOR' - to render the previously generated radar map image and the cursor over it.
         void SetRedraw( const uint32_t redrawMode ) const;
 
-        // Set the "need" of render the radar map only in the given 'roi' on next radar Redraw call.
+        // Add the tiles in the given 'roi' to the tiles to be rendered on the next radar Redraw call. Changes of fog, objects, terrain
+        // and ownership are tracked by the world itself, so this is needed only for changes which are not tracked there.
         void SetRenderArea( const fheroes2::Rect & roi );
         void Build();
         void RedrawForViewWorld( const ViewWorld::ZoomROIs & roi, ViewWorldMode mode, const bool renderMapObjects );
@@ -97,12 +99,22 @@ namespace Interface
         void RedrawObjects( const int32_t playerColor, const ViewWorldMode flags );
         void RedrawCursor( const fheroes2::Rect * roiRectangle = nullptr );
 
+        void fillTile( const int32_t x, const int32_t y, const uint8_t fillColor );
+
         RadarType _radarType;
         BaseInterface & _interface;
 
         fheroes2::Image _map;
         fheroes2::MovableSprite _cursorArea;
-        fheroes2::Rect _roi;
+
+        // Indexes of tiles to be rendered on the next update of the radar map image unless it has to be rendered fully.
+        std::set<int32_t> _tilesToRedraw;
+        bool _isFullRedrawNeeded{ true };
+
+        // Player colors and the mode used for the current radar map image. Any change of them requires a full update of the image.
+        int32_t _renderedPlayerColor{ 0 };
+        ViewWorldMode _renderedMode{ ViewWorldMode::OnlyVisible };
+
         double _zoom{ 1.0 };
         bool _hide{ true };
         bool _mouseDraggingMovement{ false };
@@ -23,6 +23,8 @@
 #include <algorithm>
 #include <cassert>
 #include <deque>
+#include <list>
+#include <unordered_map>
 
 #include "agg_image.h"
 
@@ -477,6 +479,134 @@ namespace
 
         return maxWidth;
     }
+
+    int32_t getRowCount( const std::string & text, const fheroes2::FontType fontType, const int32_t maxWidth )
+    {
+        assert( !text.empty() );
+
+        std::deque<TextLineInfo> lineInfos;
+        getMultiRowInfo( reinterpret_cast<const uint8_t *>( text.data() ), static_cast<int32_t>( text.size() ), maxWidth, fontType,
+                         fheroes2::getFontHeight( fontType.size ), lineInfos );
+
+        return static_cast<int32_t>( lineInfos.size() );
+    }
+
+    int32_t getMultiLineWidth( const std::string & text, const fheroes2::FontType fontType, const int32_t maxWidth, const bool isUniformVerticalAlignment )
+    {
+        assert( !text.empty() );
+
+        const uint8_t * data = reinterpret_cast<const uint8_t *>( text.data() );
+        const int32_t size = static_cast<int32_t>( text.size() );
+        const int32_t fontHeight = fheroes2::getFontHeight( fontType.size );
+
+        std::deque<TextLineInfo> lineInfos;
+        getMultiRowInfo( data, size, maxWidth, fontType, fontHeight, lineInfos );
+
+        if ( lineInfos.size() == 1 ) {
+            // This is a single-line message.
+            return lineInfos.front().offset.x;
+        }
+
+        if ( !isUniformVerticalAlignment ) {
+            // This is a multi-lined message and we try to fit as many words on every line as possible.
+            return std::max_element( lineInfos.begin(), lineInfos.end(), []( const TextLineInfo & a, const TextLineInfo & b ) { return a.offset.x < b.offset.x; } )
+                ->offset.x;
+        }
+
+        // This is a multi-line message. Optimize it to fit the text evenly to the same number of lines.
+        int32_t startWidth = getMaxWordWidth( data, size, fontType );
+        int32_t endWidth = maxWidth;
+
+        while ( startWidth + 1 < endWidth ) {
+            const int32_t currentWidth = ( endWidth + startWidth ) / 2;
+            std::deque<TextLineInfo> tempLineInfos;
+            getMultiRowInfo( data, size, currentWidth, fontType, fontHeight, tempLineInfos );
+
+            if ( tempLineInfos.size() > lineInfos.size() ) {
+                startWidth = currentWidth;
+                continue;
+            }
+
+            endWidth = currentWidth;
+        }
+
+        return endWidth;
+    }
+
+    // A cache of the most recently used entries for texts with the given font and line width parameters.
+    template <typename T>
+    class TextLruCache
+    {
+    public:
+        explicit TextLruCache( const size_t maxEntryCount )
+            : _maxEntryCount( maxEntryCount )
+        {
+            // Do nothing.
+        }
+
+        // Returns the entry for the given text parameters. A new entry is default constructed.
+        // The returned reference remains valid until the next call of this method.
+        T & get( const std::string & text, const fheroes2::FontType fontType, const int32_t maxWidth, const bool isUniformVerticalAlignment )
+        {
+            const uint32_t fontGeneration = fheroes2::AGG::getFontGeneration();
+            if ( _fontGeneration != fontGeneration ) {
+                _fontGeneration = fontGeneration;
+
+                _index.clear();
+                _entries.clear();
+            }
+
+            _key.clear();
+            _key.push_back( static_cast<char>( fontType.size ) );
+            _key.push_back( static_cast<char>( fontType.color ) );
+            _key.push_back( isUniformVerticalAlignment ? 1 : 0 );
+            _key.append( reinterpret_cast<const char *>( &maxWidth ), sizeof( maxWidth ) );
+            _key.append( text );
+
+            const auto iter = _index.find( _key );
+            if ( iter != _index.end() ) {
+                _entries.splice( _entries.begin(), _entries, iter->second );
+                return iter->second->second;
+            }
+
+            if ( _entries.size() >= _maxEntryCount ) {
+                _index.erase( _entries.back().first );
+                _entries.pop_back();
+            }
+
+            _entries.emplace_front( _key, T() );
+            _index.emplace( _entries.front().first, _entries.begin() );
+
+            return _entries.front().second;
+        }
+
+    private:
+        const size_t _maxEntryCount;
+
+        uint32_t _fontGeneration{ 0 };
+
+        std::list<std::pair<std::string, T>> _entries;
+
+        // Keys refer to the strings stored in the list above.
+        std::unordered_map<std::string_view, typename std::list<std::pair<std::string, T>>::iterator> _index;
+
+        // Temporary buffer to avoid memory allocations for every key.
+        std::string _key;
+    };
+
+    struct TextLayout
+    {
+        int32_t width{ -1 };
+        int32_t rows{ -1 };
+    };
+
+    // Multi-line parameters of recently measured texts. Many texts, like tooltips or status bar messages, are created from scratch
+    // every time they are drawn so their own layout cache is empty every time.
+    TextLruCache<TextLayout> textLayoutCache( 256 );
+
+    // Pre-rendered images of texts drawn by Text::drawCached() methods. Every image is cropped to its visible area and its position
+    // is the offset of this area relative to the text drawing position.
+    TextLruCache<fheroes2::Sprite> textImageCache( 128 );
 }
 
 namespace fheroes2
@@ -505,10 +635,39 @@ namespace fheroes2
 
     Text::~Text() = default;
 
+    Text::LayoutCache & Text::_getLayoutCache() const
+    {
+        const uint32_t fontGeneration = AGG::getFontGeneration();
+        if ( _layoutCache.fontGeneration != fontGeneration ) {
+            _layoutCache = {};
+            _layoutCache.fontGeneration = fontGeneration;
+        }
+
+        return _layoutCache;
+    }
+
+    Text::LayoutCache & Text::_getLayoutCache( const int32_t maxWidth ) const
+    {
+        _getLayoutCache();
+
+        if ( _layoutCache.maxWidth != maxWidth ) {
+            _layoutCache.maxWidth = maxWidth;
+            _layoutCache.multiLineWidth = -1;
+            _layoutCache.rows = -1;
+        }
+
+        return _layoutCache;
+    }
+
     // TODO: Properly handle strings with many text lines ('\n'). Now their widths are counted as if they're one line.
     int32_t Text::width() const
     {
-        return getLineWidth( reinterpret_cast<const uint8_t *>( _text.data() ), static_cast<int32_t>( _text.size() ), _fontType );
+        LayoutCache & layoutCache = _getLayoutCache();
+        if ( layoutCache.singleLineWidth < 0 ) {
+            layoutCache.singleLineWidth = getLineWidth( reinterpret_cast<const uint8_t *>( _text.data() ), static_cast<int32_t>( _text.size() ), _fontType );
+        }
+
+        return layoutCache.singleLineWidth;
     }
 
     // TODO: Properly handle strings with many text lines ('\n'). Now their heights are counted as if they're one line.
@@ -523,55 +682,26 @@ namespace fheroes2
             return 0;
         }
 
-        const int32_t fontHeight = height();
-
-        std::deque<TextLineInfo> lineInfos;
-        getMultiRowInfo( reinterpret_cast<const uint8_t *>( _text.data() ), static_cast<int32_t>( _text.size() ), maxWidth, _fontType, fontHeight, lineInfos );
-
-        if ( lineInfos.size() == 1 ) {
-            // This is a single-line message.
-            return lineInfos.front().offset.x;
+        LayoutCache & layoutCache = _getLayoutCache( maxWidth );
+        if ( layoutCache.multiLineWidth >= 0 && layoutCache.isUniformVerticalAlignment == _isUniformedVerticalAlignment ) {
+            return layoutCache.multiLineWidth;
         }
 
-        if ( !_isUniformedVerticalAlignment ) {
-            // This is a multi-lined message and we try to fit as many words on every line as possible.
-            return std::max_element( lineInfos.begin(), lineInfos.end(), []( const TextLineInfo & a, const TextLineInfo & b ) { return a.offset.x < b.offset.x; } )
-                ->offset.x;
+        TextLayout & layout = textLayoutCache.get( _text, _fontType, maxWidth, _isUniformedVerticalAlignment );
+        if ( layout.width < 0 ) {
+            layout.width = getMultiLineWidth( _text, _fontType, maxWidth, _isUniformedVerticalAlignment );
         }
 
-        // This is a multi-line message. Optimize it to fit the text evenly to the same number of lines.
-        int32_t startWidth = getMaxWordWidth( reinterpret_cast<const uint8_t *>( _text.data() ), static_cast<int32_t>( _text.size() ), _fontType );
-        int32_t endWidth = maxWidth;
-
-        while ( startWidth + 1 < endWidth ) {
-            const int32_t currentWidth = ( endWidth + startWidth ) / 2;
-            std::deque<TextLineInfo> tempLineInfos;
-            getMultiRowInfo( reinterpret_cast<const uint8_t *>( _text.data() ), static_cast<int32_t>( _text.size() ), currentWidth, _fontType, fontHeight,
-                             tempLineInfos );
+        layoutCache.multiLineWidth = layout.width;
+        layoutCache.isUniformVerticalAlignment = _isUniformedVerticalAlignment;
 
-            if ( tempLineInfos.size() > lineInfos.size() ) {
-                startWidth = currentWidth;
-                continue;
-            }
-
-            endWidth = currentWidth;
-        }
-
-        return endWidth;
+        return layoutCache.multiLineWidth;
     }
 
     int32_t Text::height( const int32_t maxWidth ) const
     {
-        if ( _text.empty() ) {
-            return 0;
-        }
-
-        const int32_t fontHeight = height();
-
-        std::deque<TextLineInfo> lineInfos;
-        getMultiRowInfo( reinterpret_cast<const uint8_t *>( _text.data() ), static_cast<int32_t>( _text.size() ), maxWidth, _fontType, fontHeight, lineInfos );
-
-        return lineInfos.back().offset.y + fontHeight;
+        // Every line has the same height.
+        return rows( maxWidth ) * height();
     }
 
     int32_t Text::rows( const int32_t maxWidth ) const
@@ -580,12 +710,19 @@ namespace fheroes2
             return 0;
         }
 
-        const int32_t fontHeight = height();
+        LayoutCache & layoutCache = _getLayoutCache( maxWidth );
+        if ( layoutCache.rows >= 0 ) {
+            return layoutCache.rows;
+        }
 
-        std::deque<TextLineInfo> lineInfos;
-        getMultiRowInfo( reinterpret_cast<const uint8_t *>( _text.data() ), static_cast<int32_t>( _text.size() ), maxWidth, _fontType, fontHeight, lineInfos );
+        TextLayout & layout = textLayoutCache.get( _text, _fontType, maxWidth, _isUniformedVerticalAlignment );
+        if ( layout.rows < 0 ) {
+            layout.rows = getRowCount( _text, _fontType, maxWidth );
+        }
 
-        return static_cast<int32_t>( lineInfos.size() );
+        layoutCache.rows = layout.rows;
+
+        return layoutCache.rows;
     }
 
     void Text::drawInRoi( const int32_t x, const int32_t y, Image & output, const Rect & imageRoi ) const
@@ -625,6 +762,65 @@ namespace fheroes2
                          _fontType, fontHeight, true, lineInfos );
     }
 
+    void Text::drawCached( const int32_t x, const int32_t y, Image & output ) const
+    {
+        if ( output.empty() || _text.empty() ) {
+            // No use to render something on an empty image or if something is empty.
+            return;
+        }
+
+        const Sprite & image = _getCachedImage( 0 );
+        Blit( image, output, x + image.x(), y + image.y() );
+    }
+
+    void Text::drawCached( const int32_t x, const int32_t y, const int32_t maxWidth, Image & output ) const
+    {
+        if ( output.empty() || _text.empty() ) {
+            // No use to render something on an empty image or if something is empty.
+            return;
+        }
+
+        assert( maxWidth > 0 ); // Why is the limit less than 1?
+        if ( maxWidth <= 0 ) {
+            drawCached( x, y, output );
+            return;
+        }
+
+        const Sprite & image = _getCachedImage( maxWidth );
+        Blit( image, output, x + image.x(), y + image.y() );
+    }
+
+    const Sprite & Text::_getCachedImage( const int32_t maxWidth ) const
+    {
+        Sprite & image = textImageCache.get( _text, _fontType, maxWidth, _isUniformedVerticalAlignment );
+        if ( !image.empty() ) {
+            return image;
+        }
+
+        const int32_t fontHeight = height();
+
+        // Some glyphs might go beyond the text area so leave some space around it.
+        const int32_t margin = fontHeight;
+
+        Image area( ( maxWidth > 0 ? maxWidth : width() ) + 2 * margin, ( maxWidth > 0 ? height( maxWidth ) : fontHeight ) + 2 * margin );
+        area.reset();
+
+        if ( maxWidth > 0 ) {
+            drawInRoi( margin, margin, maxWidth, area, { 0, 0, area.width(), area.height() } );
+        }
+        else {
+            drawInRoi( margin, margin, area, { 0, 0, area.width(), area.height() } );
+        }
+
+        // Shadows must be kept as well.
+        const Rect roi = GetActiveROI( area, 2 );
+
+        image = Crop( area, roi.x, roi.y, roi.width, roi.height );
+        image.setPosition( roi.x - margin, roi.y - margin );
+
+        return image;
+    }
+
     bool Text::empty() const
     {
         return _text.empty();
@@ -659,6 +855,8 @@ namespace fheroes2
 
         _text.resize( maxCharacterCount );
         _text += truncatedEnding;
+
+        _layoutCache = {};
     }
 
     std::string Text::text() const
@@ -672,6 +870,8 @@ namespace fheroes2
     {
         if ( !text._text.empty() ) {
             _texts.emplace_back( std::move( text ) );
+
+            _layoutCache = {};
         }
     }
 
@@ -699,8 +899,21 @@ namespace fheroes2
         return maxHeight;
     }
 
-    int32_t MultiFontText::width( const int32_t maxWidth ) const
+    const MultiFontText::LayoutCache & MultiFontText::_getLayoutCache( const int32_t maxWidth ) const
     {
+        const uint32_t fontGeneration = AGG::getFontGeneration();
+        if ( _layoutCache.maxWidth == maxWidth && _layoutCache.fontGeneration == fontGeneration ) {
+            return _layoutCache;
+        }
+
+        _layoutCache = {};
+        _layoutCache.fontGeneration = fontGeneration;
+        _layoutCache.maxWidth = maxWidth;
+
+        if ( _texts.empty() ) {
+            return _layoutCache;
+        }
+
         const int32_t maxFontHeight = height();
 
         std::deque<TextLineInfo> lineInfos;
@@ -709,49 +922,29 @@ namespace fheroes2
                              lineInfos );
         }
 
-        int32_t maxRowWidth = lineInfos.front().offset.x;
         for ( const TextLineInfo & lineInfo : lineInfos ) {
-            maxRowWidth = std::max( maxRowWidth, lineInfo.offset.x );
+            _layoutCache.width = std::max( _layoutCache.width, lineInfo.offset.x );
         }
 
-        return maxRowWidth;
+        _layoutCache.rows = static_cast<int32_t>( lineInfos.size() );
+
+        return _layoutCache;
     }
 
-    int32_t MultiFontText::height( const int32_t maxWidth ) const
+    int32_t MultiFontText::width( const int32_t maxWidth ) const
     {
-        const int32_t maxFontHeight = height();
+        return _getLayoutCache( maxWidth ).width;
+    }
 
-        std::deque<TextLineInfo> lineInfos;
-        for ( const Text & text : _texts ) {
-            getMultiRowInfo( reinterpret_cast<const uint8_t *>( text._text.data() ), static_cast<int32_t>( text._text.size() ), maxWidth, text._fontType, maxFontHeight,
-                             lineInfos );
-        }
-        return lineInfos.back().offset.y + maxFontHeight;
+    int32_t MultiFontText::height( const int32_t maxWidth ) const
+    {
+        // Every line has the height of the highest font.
+        return _getLayoutCache( maxWidth ).rows * height();
     }
 
     int32_t MultiFontText::rows( const int32_t maxWidth ) const
     {
-        if ( _texts.empty() ) {
-            return 0;
-        }
-
-        const int32_t maxFontHeight = height();
-
-        std::deque<TextLineInfo> lineInfos;
-        for ( const Text & text : _texts ) {
-            if ( text._text.empty() ) {
-                continue;
-            }
-
-            getMultiRowInfo( reinterpret_cast<const uint8_t *>( text._text.data() ), static_cast<int32_t>( text._text.size() ), maxWidth, text._fontType, maxFontHeight,
-                             lineInfos );
-        }
-
-        if ( lineInfos.empty() ) {
-            return 0;
-        }
-
-        return static_cast<int32_t>( lineInfos.size() );
+        return _getLayoutCache( maxWidth ).rows;
     }
 
     void MultiFontText::drawInRoi( const int32_t x, const int32_t y, Image & output, const Rect & imageRoi ) const
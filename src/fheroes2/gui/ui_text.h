@@ -179,12 +179,19 @@ namespace fheroes2
         void drawInRoi( const int32_t x, const int32_t y, Image & output, const Rect & imageRoi ) const override;
         void drawInRoi( const int32_t x, const int32_t y, const int32_t maxWidth, Image & output, const Rect & imageRoi ) const override;
 
+        // Draw text the same way as draw() methods do but using a pre-rendered image of it. The image is rendered once and reused
+        // for the same text, font and line width. This is useful for static labels which are redrawn often.
+        void drawCached( const int32_t x, const int32_t y, Image & output ) const;
+        void drawCached( const int32_t x, const int32_t y, const int32_t maxWidth, Image & output ) const;
+
         bool empty() const override;
 
         void set( std::string text, const FontType fontType )
         {
             _text = std::move( text );
             _fontType = fontType;
+
+            _layoutCache = {};
         }
 
         // This method modifies the underlying text and ends it with '...' if it is longer than the provided width.
@@ -199,9 +206,33 @@ namespace fheroes2
         }
 
     private:
+        // Measured parameters of the text. They are calculated on demand and reset every time the text is changed.
+        struct LayoutCache
+        {
+            uint32_t fontGeneration{ 0 };
+
+            int32_t singleLineWidth{ -1 };
+
+            // Maximum width of a line for which the multi-line parameters below are calculated.
+            int32_t maxWidth{ 0 };
+            int32_t multiLineWidth{ -1 };
+            bool isUniformVerticalAlignment{ false };
+            int32_t rows{ -1 };
+        };
+
+        LayoutCache & _getLayoutCache() const;
+
+        // Resets the multi-line parameters if they were calculated for another maximum width of a line.
+        LayoutCache & _getLayoutCache( const int32_t maxWidth ) const;
+
+        // Returns the pre-rendered image of the text. Zero maximum width means a single-line text.
+        const Sprite & _getCachedImage( const int32_t maxWidth ) const;
+
         std::string _text;
 
         FontType _fontType;
+
+        mutable LayoutCache _layoutCache;
     };
 
     class MultiFontText : public TextBase
@@ -228,7 +259,20 @@ namespace fheroes2
         std::string text() const override;
 
     private:
+        // Multi-line parameters of the text calculated for the given maximum width of a line. They are reset every time a new text is added.
+        struct LayoutCache
+        {
+            uint32_t fontGeneration{ 0 };
+            int32_t maxWidth{ 0 };
+            int32_t width{ 0 };
+            int32_t rows{ 0 };
+        };
+
+        const LayoutCache & _getLayoutCache( const int32_t maxWidth ) const;
+
         std::vector<Text> _texts;
+
+        mutable LayoutCache _layoutCache;
     };
 
     class FontCharHandler
@@ -958,6 +958,8 @@ void Heroes::IncreasePrimarySkill( int skill )
     default:
         break;
     }
+
+    Army::invalidateStrengthCache();
 }
 
 uint32_t Heroes::GetMaxSpellPoints() const
@@ -1136,6 +1138,9 @@ bool Heroes::Recruit( const int col, const fheroes2::Point & pt )
     world.GetTiles( pt.x, pt.y ).setHero( this );
 
     kingdom.AddHero( this );
+
+    Army::invalidateStrengthCache();
+
     // Update the set of recruits in the kingdom
     kingdom.GetRecruits();
 
@@ -1296,6 +1301,9 @@ void Heroes::SetVisited( int32_t index, Visit::Type type )
     }
     else if ( !isVisited( tile ) && MP2::OBJ_NONE != objectType ) {
         visit_object.emplace_front( index, objectType );
+
+        // Some visited objects affect the morale and luck of the hero
+        Army::invalidateStrengthCache();
     }
 }
 
@@ -1713,8 +1721,11 @@ int Heroes::GetLevelSkill( int skill ) const
 
 void Heroes::LearnSkill( const Skill::Secondary & skill )
 {
-    if ( skill.isValid() )
+    if ( skill.isValid() ) {
         secondary_skills.AddSkill( skill );
+
+        Army::invalidateStrengthCache();
+    }
 }
 
 void Heroes::Scout( const int tileIndex ) const
@@ -1829,6 +1840,8 @@ void Heroes::LevelUp( bool skipsecondary, bool autoselect )
     if ( !skipsecondary ) {
         LevelUpSecondarySkill( seeds, primarySkill, autoselect );
     }
+
+    Army::invalidateStrengthCache();
 }
 
 void Heroes::LevelUpSecondarySkill( const HeroSeedsForLevelUp & seeds, int primary, bool autoselect )
@@ -1956,6 +1969,8 @@ void Heroes::Dismiss( int reason )
     world.GetTiles( GetIndex() ).setHero( nullptr );
     SetIndex( -1 );
 
+    Army::invalidateStrengthCache();
+
     modes = 0;
 
     path.Hide();
@@ -2027,9 +2042,16 @@ void Heroes::Move2Dest( const int32_t dstIndex )
         return;
     }
 
+    const Castle * previousCastle = inCastle();
+
     world.GetTiles( currentIndex ).setHero( nullptr );
     SetIndex( dstIndex );
     world.GetTiles( dstIndex ).setHero( this );
+
+    // Castle buildings affect the morale and luck of the hero's army
+    if ( previousCastle != inCastle() ) {
+        Army::invalidateStrengthCache();
+    }
 }
 
 const fheroes2::Sprite & Heroes::GetPortrait( int id, int type )
@@ -186,8 +186,12 @@ bool HeroBase::HaveSpell( const Spell & spell, const bool skip_bag ) const
 
 void HeroBase::AppendSpellToBook( const Spell & spell, const bool without_wisdom )
 {
-    if ( without_wisdom || CanLearnSpell( spell ) )
+    if ( without_wisdom || CanLearnSpell( spell ) ) {
         spell_book.Append( spell );
+
+        // Known spells affect the magic strategic value of the hero
+        Army::invalidateStrengthCache();
+    }
 }
 
 void HeroBase::AppendSpellsToBook( const SpellStorage & spells, const bool without_wisdom )
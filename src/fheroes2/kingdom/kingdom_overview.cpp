@@ -340,19 +340,19 @@ namespace
         const int32_t offsetY = dsty + 22;
 
         fheroes2::Text text( std::to_string( row.hero->GetAttack() ), fheroes2::FontType::smallWhite() );
-        text.draw( offsetX - text.width(), offsetY, display );
+        text.drawCached( offsetX - text.width(), offsetY, display );
 
         offsetX += 35;
         text.set( std::to_string( row.hero->GetDefense() ), fheroes2::FontType::smallWhite() );
-        text.draw( offsetX - text.width(), offsetY, display );
+        text.drawCached( offsetX - text.width(), offsetY, display );
 
         offsetX += 35;
         text.set( std::to_string( row.hero->GetPower() ), fheroes2::FontType::smallWhite() );
-        text.draw( offsetX - text.width(), offsetY, display );
+        text.drawCached( offsetX - text.width(), offsetY, display );
 
         offsetX += 35;
         text.set( std::to_string( row.hero->GetKnowledge() ), fheroes2::FontType::smallWhite() );
-        text.draw( offsetX - text.width(), offsetY, display );
+        text.drawCached( offsetX - text.width(), offsetY, display );
 
         // primary skills info
         row.primSkillsBar->setRenderingOffset( { dstx + 56, dsty - 3 } );
@@ -381,13 +381,13 @@ namespace
         const int32_t offsetY = dst.y + 3;
 
         fheroes2::Text text( _( "Hero/Stats" ), fheroes2::FontType::smallWhite() );
-        text.draw( dst.x + 130 - text.width() / 2, offsetY, display );
+        text.drawCached( dst.x + 130 - text.width() / 2, offsetY, display );
 
         text.set( _( "Skills" ), fheroes2::FontType::smallWhite() );
-        text.draw( dst.x + 300 - text.width() / 2, offsetY, display );
+        text.drawCached( dst.x + 300 - text.width() / 2, offsetY, display );
 
         text.set( _( "Artifacts" ), fheroes2::FontType::smallWhite() );
-        text.draw( dst.x + 500 - text.width() / 2, offsetY, display );
+        text.drawCached( dst.x + 500 - text.width() / 2, offsetY, display );
 
         redrawCommonBackground( dst, VisibleItemCount(), display );
     }
@@ -631,7 +631,7 @@ namespace
             const fheroes2::Text text( std::to_string( hero->GetAttack() ) + sep + std::to_string( hero->GetDefense() ) + sep + std::to_string( hero->GetPower() ) + sep
                                            + std::to_string( hero->GetKnowledge() ),
                                        fheroes2::FontType::smallWhite() );
-            text.draw( dstx + 104 - text.width() / 2, dsty + 45, display );
+            text.drawCached( dstx + 104 - text.width() / 2, dsty + 45, display );
         }
         else if ( row.castle->GetCaptain().isValid() ) {
             const Captain & captain = row.castle->GetCaptain();
@@ -641,11 +641,11 @@ namespace
             const fheroes2::Text text( std::to_string( captain.GetAttack() ) + sep + std::to_string( captain.GetDefense() ) + sep + std::to_string( captain.GetPower() )
                                            + sep + std::to_string( captain.GetKnowledge() ),
                                        fheroes2::FontType::smallWhite() );
-            text.draw( dstx + 104 - text.width() / 2, dsty + 45, display );
+            text.drawCached( dstx + 104 - text.width() / 2, dsty + 45, display );
         }
 
         const fheroes2::Text text( row.castle->GetName(), fheroes2::FontType::smallWhite() );
-        text.draw( dstx + 72 - text.width() / 2, dsty + 63, display );
+        text.drawCached( dstx + 72 - text.width() / 2, dsty + 63, display );
 
         // army info
         if ( row.garrisonArmyBar ) {
@@ -672,13 +672,13 @@ namespace
         const int32_t offsetY = dst.y + 3;
 
         fheroes2::Text text( _( "Town/Castle" ), fheroes2::FontType::smallWhite() );
-        text.draw( dst.x + 105 - text.width() / 2, offsetY, display );
+        text.drawCached( dst.x + 105 - text.width() / 2, offsetY, display );
 
         text.set( _( "Garrison" ), fheroes2::FontType::smallWhite() );
-        text.draw( dst.x + 275 - text.width() / 2, offsetY, display );
+        text.drawCached( dst.x + 275 - text.width() / 2, offsetY, display );
 
         text.set( _( "Available" ), fheroes2::FontType::smallWhite() );
-        text.draw( dst.x + 500 - text.width() / 2, offsetY, display );
+        text.drawCached( dst.x + 500 - text.width() / 2, offsetY, display );
 
         redrawCommonBackground( dst, VisibleItemCount(), display );
     }
@@ -690,25 +690,25 @@ namespace
         fheroes2::Display & display = fheroes2::Display::instance();
 
         fheroes2::Text text( CapturedExtInfoString( Resource::WOOD, myKingdom.GetColor(), income ), fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 54 - text.width() / 2, offsetY, display );
+        text.drawCached( pt.x + 54 - text.width() / 2, offsetY, display );
 
         text.set( CapturedExtInfoString( Resource::MERCURY, myKingdom.GetColor(), income ), fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 146 - text.width() / 2, offsetY, display );
+        text.drawCached( pt.x + 146 - text.width() / 2, offsetY, display );
 
         text.set( CapturedExtInfoString( Resource::ORE, myKingdom.GetColor(), income ), fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 228 - text.width() / 2, offsetY, display );
+        text.drawCached( pt.x + 228 - text.width() / 2, offsetY, display );
 
         text.set( CapturedExtInfoString( Resource::SULFUR, myKingdom.GetColor(), income ), fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 294 - text.width() / 2, offsetY, display );
+        text.drawCached( pt.x + 294 - text.width() / 2, offsetY, display );
 
         text.set( CapturedExtInfoString( Resource::CRYSTAL, myKingdom.GetColor(), income ), fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 360 - text.width() / 2, offsetY, display );
+        text.drawCached( pt.x + 360 - text.width() / 2, offsetY, display );
 
         text.set( CapturedExtInfoString( Resource::GEMS, myKingdom.GetColor(), income ), fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 428 - text.width() / 2, offsetY, display );
+        text.drawCached( pt.x + 428 - text.width() / 2, offsetY, display );
 
         text.set( CapturedExtInfoString( Resource::GOLD, myKingdom.GetColor(), income ), fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 494 - text.width() / 2, offsetY, display );
+        text.drawCached( pt.x + 494 - text.width() / 2, offsetY, display );
     }
 
     void RedrawFundsInfo( const fheroes2::Point & pt, const Kingdom & myKingdom )
@@ -720,39 +720,39 @@ namespace
         fheroes2::Blit( fheroes2::AGG::GetICN( ICN::OVERBACK, 0 ), 4, 422, display, pt.x + 4, pt.y + 422, 530, 56 );
 
         fheroes2::Text text( std::to_string( funds.wood ), fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 56 - text.width() / 2, offsetY, display );
+        text.drawCached( pt.x + 56 - text.width() / 2, offsetY, display );
 
         text.set( std::to_string( funds.mercury ), fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 146 - text.width() / 2, offsetY, display );
+        text.drawCached( pt.x + 146 - text.width() / 2, offsetY, display );
 
         text.set( std::to_string( funds.ore ), fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 226 - text.width() / 2, offsetY, display );
+        text.drawCached( pt.x + 226 - text.width() / 2, offsetY, display );
 
         text.set( std::to_string( funds.sulfur ), fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 294 - text.width() / 2, offsetY, display );
+        text.drawCached( pt.x + 294 - text.width() / 2, offsetY, display );
 
         text.set( std::to_string( funds.crystal ), fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 362 - text.width() / 2, offsetY, display );
+        text.drawCached( pt.x + 362 - text.width() / 2, offsetY, display );
 
         text.set( std::to_string( funds.gems ), fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 428 - text.width() / 2, offsetY, display );
+        text.drawCached( pt.x + 428 - text.width() / 2, offsetY, display );
 
         text.set( std::to_string( funds.gold ), fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 496 - text.width() / 2, offsetY, display );
+        text.drawCached( pt.x + 496 - text.width() / 2, offsetY, display );
 
         offsetY += 14;
         text.set( _( "Gold Per Day:" ) + std::string( " " ) + std::to_string( myKingdom.GetIncome().Get( Resource::GOLD ) ), fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 180, offsetY, display );
+        text.drawCached( pt.x + 180, offsetY, display );
 
         std::string msg = _( "Day: %{day}" );
         StringReplace( msg, "%{day}", world.GetDay() );
         text.set( msg, fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 360, offsetY, display );
+        text.drawCached( pt.x + 360, offsetY, display );
 
         // Show Lighthouse count
         const uint32_t lighthouseCount = world.CountCapturedObject( MP2::OBJ_LIGHTHOUSE, myKingdom.GetColor() );
         text.set( std::to_string( lighthouseCount ), fheroes2::FontType::smallWhite() );
-        text.draw( pt.x + 105, offsetY, display );
+        text.drawCached( pt.x + 105, offsetY, display );
 
         const fheroes2::Sprite & lighthouse = fheroes2::AGG::GetICN( ICN::OVERVIEW, 14 );
         fheroes2::Blit( lighthouse, 0, 0, display, pt.x + 100 - lighthouse.width(), pt.y + 459, lighthouse.width(), lighthouse.height() );
@@ -182,67 +182,108 @@ namespace
         }
     }
 
-    struct CacheForMapWithResources
-    {
-        std::array<fheroes2::Image, zoomLevels> cachedImages; // One image per zoom Level
-
-        CacheForMapWithResources() = delete;
+    // The world map is rendered by square blocks of tiles. Standard map sizes are multiples of this size.
+    const int32_t blockSize = 18;
 
-        // Compute complete world map, and save it for all zoom levels
-        explicit CacheForMapWithResources( const ViewWorldMode viewMode, Interface::GameArea & gameArea )
+    // Images of the world map for all zoom levels without icons of objects. The map is rendered by blocks of tiles only when they are
+    // about to be displayed, and rendered blocks are kept between invocations of the View World window until the world changes.
+    class WorldMapCache
+    {
+    public:
+        // Discards all rendered blocks if they do not match the current state of the world or the given rendering parameters.
+        void prepare( const ViewWorldMode viewMode, const int32_t color )
         {
-            for ( int32_t i = 0; i < zoomLevels; ++i ) {
-                cachedImages[i]._disableTransformLayer();
-                cachedImages[i].resize( world.w() * tileSizePerZoomLevel[i], world.h() * tileSizePerZoomLevel[i] );
+            int32_t drawingFlags = Interface::RedrawLevelType::LEVEL_ALL & ~Interface::RedrawLevelType::LEVEL_ROUTES;
+            if ( viewMode == ViewWorldMode::ViewAll ) {
+                drawingFlags &= ~Interface::RedrawLevelType::LEVEL_FOG;
+            }
+            else if ( viewMode == ViewWorldMode::ViewTowns ) {
+                drawingFlags |= Interface::RedrawLevelType::LEVEL_TOWNS;
             }
 
-            const int32_t blockSizeX = 18;
-            const int32_t blockSizeY = 18;
+#if !defined( SAVE_WORLD_MAP )
+            drawingFlags ^= Interface::RedrawLevelType::LEVEL_HEROES;
+#endif
 
             const int32_t worldWidth = world.w();
             const int32_t worldHeight = world.h();
 
+            if ( _isValid && _drawingFlags == drawingFlags && _color == color && _tilesGeneration == world.getTilesGeneration() && _worldWidth == worldWidth
+                 && _worldHeight == worldHeight ) {
+                return;
+            }
+
             // Assert will fail in case we add non-standard map sizes, otherwise standard map sizes are multiples of 18 tiles
-            assert( worldWidth % blockSizeX == 0 );
-            assert( worldHeight % blockSizeY == 0 );
+            assert( worldWidth % blockSize == 0 );
+            assert( worldHeight % blockSize == 0 );
+
+            _drawingFlags = drawingFlags;
+            _color = color;
+            _tilesGeneration = world.getTilesGeneration();
+            _worldWidth = worldWidth;
+            _worldHeight = worldHeight;
+            _isValid = true;
+
+            for ( int32_t i = 0; i < zoomLevels; ++i ) {
+                _images[i]._disableTransformLayer();
+                _images[i].resize( worldWidth * tileSizePerZoomLevel[i], worldHeight * tileSizePerZoomLevel[i] );
+            }
+
+            _isBlockRendered.assign( static_cast<size_t>( worldWidth / blockSize ) * ( worldHeight / blockSize ), 0 );
+        }
+
+        // Renders the blocks which are needed to display the given area of the image of the given zoom level and have not been rendered yet.
+        // Every block is rendered for all zoom levels at once. Returns true if any block has been rendered.
+        bool renderArea( const int32_t zoomLevelId, const fheroes2::Rect & roi, Interface::GameArea & gameArea )
+        {
+            assert( _isValid );
 
-            const int32_t redrawAreaWidth = blockSizeX * TILEWIDTH;
-            const int32_t redrawAreaHeight = blockSizeY * TILEWIDTH;
-            const int32_t redrawAreaCenterX = blockSizeX * TILEWIDTH / 2;
-            const int32_t redrawAreaCenterY = blockSizeY * TILEWIDTH / 2;
+            const fheroes2::Image & image = _images[zoomLevelId];
+            const fheroes2::Rect area = roi ^ fheroes2::Rect( 0, 0, image.width(), image.height() );
+            if ( area.width <= 0 || area.height <= 0 ) {
+                return false;
+            }
+
+            const int32_t blockSizeInPixels = blockSize * tileSizePerZoomLevel[zoomLevelId];
+            const int32_t blocksPerRow = _worldWidth / blockSize;
+
+            std::vector<fheroes2::Point> blocksToRender;
+
+            for ( int32_t blockY = area.y / blockSizeInPixels; blockY <= ( area.y + area.height - 1 ) / blockSizeInPixels; ++blockY ) {
+                for ( int32_t blockX = area.x / blockSizeInPixels; blockX <= ( area.x + area.width - 1 ) / blockSizeInPixels; ++blockX ) {
+                    uint8_t & isRendered = _isBlockRendered[static_cast<size_t>( blockY ) * blocksPerRow + blockX];
+                    if ( isRendered == 0 ) {
+                        isRendered = 1;
+                        blocksToRender.emplace_back( blockX * blockSize, blockY * blockSize );
+                    }
+                }
+            }
+
+            if ( blocksToRender.empty() ) {
+                return false;
+            }
+
+            const int32_t redrawAreaSize = blockSize * TILEWIDTH;
 
             // Create temporary image where we will draw blocks of the main map on
             fheroes2::Image temporaryImg;
             temporaryImg._disableTransformLayer();
-            temporaryImg.resize( redrawAreaWidth, redrawAreaHeight );
+            temporaryImg.resize( redrawAreaSize, redrawAreaSize );
 
             // Remember the original game area ROI and center of the view.
             const fheroes2::Rect gameAreaRoi( gameArea.GetROI() );
             const fheroes2::Point gameAreaCenter( gameArea.getCurrentCenterInPixels() );
 
-            gameArea.SetAreaPosition( 0, 0, redrawAreaWidth, redrawAreaHeight );
-            int32_t drawingFlags = Interface::RedrawLevelType::LEVEL_ALL & ~Interface::RedrawLevelType::LEVEL_ROUTES;
-            if ( viewMode == ViewWorldMode::ViewAll ) {
-                drawingFlags &= ~Interface::RedrawLevelType::LEVEL_FOG;
-            }
-            else if ( viewMode == ViewWorldMode::ViewTowns ) {
-                drawingFlags |= Interface::RedrawLevelType::LEVEL_TOWNS;
-            }
-
-#if !defined( SAVE_WORLD_MAP )
-            drawingFlags ^= Interface::RedrawLevelType::LEVEL_HEROES;
-#endif
+            gameArea.SetAreaPosition( 0, 0, redrawAreaSize, redrawAreaSize );
 
-            // Draw sub-blocks of the main map, and resize them to draw them on lower-res cached versions:
-            for ( int32_t x = 0; x < worldWidth; x += blockSizeX ) {
-                for ( int32_t y = 0; y < worldHeight; y += blockSizeY ) {
-                    gameArea.SetCenterInPixels( { x * TILEWIDTH + redrawAreaCenterX, y * TILEWIDTH + redrawAreaCenterY } );
-                    gameArea.Redraw( temporaryImg, drawingFlags );
+            // Draw blocks of the main map, and resize them to draw them on lower-res cached versions:
+            for ( const fheroes2::Point & block : blocksToRender ) {
+                gameArea.SetCenterInPixels( { block.x * TILEWIDTH + redrawAreaSize / 2, block.y * TILEWIDTH + redrawAreaSize / 2 } );
+                gameArea.Redraw( temporaryImg, _drawingFlags );
 
-                    for ( int32_t i = 0; i < zoomLevels; ++i ) {
-                        fheroes2::Resize( temporaryImg, 0, 0, temporaryImg.width(), temporaryImg.height(), cachedImages[i], x * tileSizePerZoomLevel[i],
-                                          y * tileSizePerZoomLevel[i], blockSizeX * tileSizePerZoomLevel[i], blockSizeY * tileSizePerZoomLevel[i] );
-                    }
+                for ( int32_t i = 0; i < zoomLevels; ++i ) {
+                    fheroes2::Resize( temporaryImg, 0, 0, temporaryImg.width(), temporaryImg.height(), _images[i], block.x * tileSizePerZoomLevel[i],
+                                      block.y * tileSizePerZoomLevel[i], blockSize * tileSizePerZoomLevel[i], blockSize * tileSizePerZoomLevel[i] );
                 }
             }
 
@@ -250,20 +291,44 @@ namespace
             gameArea.SetAreaPosition( gameAreaRoi.x, gameAreaRoi.y, gameAreaRoi.width, gameAreaRoi.height );
             gameArea.SetCenterInPixels( gameAreaCenter );
 
-#if defined( SAVE_WORLD_MAP )
-            fheroes2::Save( cachedImages[3], Settings::Get().getCurrentMapInfo().name + saveFilePrefix + ".bmp" );
-#endif
+            return true;
         }
+
+        const fheroes2::Image & getImage( const int32_t zoomLevelId ) const
+        {
+            return _images[zoomLevelId];
+        }
+
+    private:
+        std::array<fheroes2::Image, zoomLevels> _images;
+
+        std::vector<uint8_t> _isBlockRendered;
+
+        int32_t _drawingFlags{ 0 };
+        int32_t _color{ 0 };
+        uint32_t _tilesGeneration{ 0 };
+        int32_t _worldWidth{ 0 };
+        int32_t _worldHeight{ 0 };
+        bool _isValid{ false };
     };
 
-    void DrawWorld( const ViewWorld::ZoomROIs & ROI, CacheForMapWithResources & cache, const fheroes2::Rect & roiScreen )
+    WorldMapCache worldMapCache;
+
+    // Returns the position of the visible area within the image of the current zoom level. It can be negative if the image is smaller than the area.
+    fheroes2::Point getImageOffset( const ViewWorld::ZoomROIs & ROI )
+    {
+        const int32_t tileSize = tileSizePerZoomLevel[static_cast<uint8_t>( ROI.getZoomLevel() )];
+
+        return { tileSize * ROI.GetROIinPixels().x / TILEWIDTH, tileSize * ROI.GetROIinPixels().y / TILEWIDTH };
+    }
+
+    void DrawWorld( const ViewWorld::ZoomROIs & ROI, const fheroes2::Image & image, const fheroes2::Rect & roiScreen )
     {
         fheroes2::Display & display = fheroes2::Display::instance();
-        const uint8_t zoomLevelId = static_cast<uint8_t>( ROI.getZoomLevel() );
-        const fheroes2::Image & image = cache.cachedImages[zoomLevelId];
 
-        const int32_t offsetPixelsX = tileSizePerZoomLevel[zoomLevelId] * ROI.GetROIinPixels().x / TILEWIDTH;
-        const int32_t offsetPixelsY = tileSizePerZoomLevel[zoomLevelId] * ROI.GetROIinPixels().y / TILEWIDTH;
+        const fheroes2::Point imageOffset = getImageOffset( ROI );
+        const int32_t offsetPixelsX = imageOffset.x;
+        const int32_t offsetPixelsY = imageOffset.y;
 
         const fheroes2::Point inPos( offsetPixelsX < 0 ? 0 : offsetPixelsX, offsetPixelsY < 0 ? 0 : offsetPixelsY );
         const fheroes2::Point outPos( BORDERWIDTH + ( offsetPixelsX < 0 ? -offsetPixelsX : 0 ), BORDERWIDTH + ( offsetPixelsY < 0 ? -offsetPixelsY : 0 ) );
@@ -300,7 +365,7 @@ namespace
         }
     }
 
-    void DrawObjectsIcons( const int32_t color, const ViewWorldMode mode, CacheForMapWithResources & cache )
+    void DrawObjectsIcons( const int32_t color, const ViewWorldMode mode, const int32_t zoomLevelId, fheroes2::Image & image )
     {
         const bool revealAll = mode == ViewWorldMode::ViewAll;
         const bool revealMines = revealAll || ( mode == ViewWorldMode::ViewMines );
@@ -313,38 +378,33 @@ namespace
         const int32_t worldHeight = world.h();
         assert( worldWidth >= 0 && worldHeight >= 0 );
 
-        // Render two flags to the left and to the right of Castle/Town entrance.
-        const auto renderCastleFlags = [&cache]( const uint32_t icnIndex, const int32_t posX, const int32_t posY ) {
-            for ( int32_t zoomLevelId = 0; zoomLevelId < zoomLevels; ++zoomLevelId ) {
-                const int32_t tileSize = tileSizePerZoomLevel[zoomLevelId];
+        const int32_t tileSize = tileSizePerZoomLevel[zoomLevelId];
 
-                const int32_t icnFlagsBase = icnPerZoomLevelFlags[zoomLevelId];
-                const uint32_t flagIndex = ( icnFlagsBase == ICN::FLAG32 ) ? ( 2 * icnIndex + 1 ) : icnIndex;
-                const fheroes2::Sprite & sprite = fheroes2::AGG::GetICN( icnFlagsBase, flagIndex );
+        // Render two flags to the left and to the right of Castle/Town entrance.
+        const auto renderCastleFlags = [&image, tileSize, zoomLevelId]( const uint32_t icnIndex, const int32_t posX, const int32_t posY ) {
+            const int32_t icnFlagsBase = icnPerZoomLevelFlags[zoomLevelId];
+            const uint32_t flagIndex = ( icnFlagsBase == ICN::FLAG32 ) ? ( 2 * icnIndex + 1 ) : icnIndex;
+            const fheroes2::Sprite & sprite = fheroes2::AGG::GetICN( icnFlagsBase, flagIndex );
 
-                const int32_t dstx = posX * tileSize + ( tileSize - sprite.width() ) / 2;
-                const int32_t dsty = posY * tileSize + ( tileSize - sprite.height() ) / 2 + 1;
+            const int32_t dstx = posX * tileSize + ( tileSize - sprite.width() ) / 2;
+            const int32_t dsty = posY * tileSize + ( tileSize - sprite.height() ) / 2 + 1;
 
-                fheroes2::Blit( sprite, cache.cachedImages[zoomLevelId], dstx + tileSize, dsty, false );
-                // We place a second flag, flipped horizontally.
-                fheroes2::Blit( sprite, cache.cachedImages[zoomLevelId], dstx - tileSize, dsty, true );
-            }
+            fheroes2::Blit( sprite, image, dstx + tileSize, dsty, false );
+            // We place a second flag, flipped horizontally.
+            fheroes2::Blit( sprite, image, dstx - tileSize, dsty, true );
         };
 
         // Render hero/artifact icon.
-        const auto renderIcon = [&cache]( const uint32_t icnIndex, const int32_t posX, const int32_t posY ) {
-            for ( int32_t zoomLevelId = 0; zoomLevelId < zoomLevels; ++zoomLevelId ) {
-                const int32_t tileSize = tileSizePerZoomLevel[zoomLevelId];
-                const int32_t dstx = posX * tileSize + tileSize / 2;
-                const int32_t dsty = posY * tileSize + tileSize / 2;
-
-                const fheroes2::Sprite & sprite = fheroes2::AGG::GetICN( icnPerZoomLevel[zoomLevelId], icnIndex );
-                fheroes2::Blit( sprite, cache.cachedImages[zoomLevelId], dstx - sprite.width() / 2, dsty - sprite.height() / 2 );
-            }
+        const auto renderIcon = [&image, tileSize, zoomLevelId]( const uint32_t icnIndex, const int32_t posX, const int32_t posY ) {
+            const int32_t dstx = posX * tileSize + tileSize / 2;
+            const int32_t dsty = posY * tileSize + tileSize / 2;
+
+            const fheroes2::Sprite & sprite = fheroes2::AGG::GetICN( icnPerZoomLevel[zoomLevelId], icnIndex );
+            fheroes2::Blit( sprite, image, dstx - sprite.width() / 2, dsty - sprite.height() / 2 );
         };
 
         // Render resource/mine icon with letter inside.
-        const auto renderResourceIcon = [&cache]( const uint32_t icnIndex, const uint32_t resource, const int32_t posX, const int32_t posY ) {
+        const auto renderResourceIcon = [&image, tileSize, zoomLevelId]( const uint32_t icnIndex, const uint32_t resource, const int32_t posX, const int32_t posY ) {
             const uint32_t letterIndex = resourceToOffsetICN( resource );
 
             if ( letterIndex == unknownIndex ) {
@@ -352,16 +412,13 @@ namespace
                 return;
             }
 
-            for ( int32_t zoomLevelId = 0; zoomLevelId < zoomLevels; ++zoomLevelId ) {
-                const int32_t tileSize = tileSizePerZoomLevel[zoomLevelId];
-                const int32_t dstx = posX * tileSize + tileSize / 2;
-                const int32_t dsty = posY * tileSize + tileSize / 2;
+            const int32_t dstx = posX * tileSize + tileSize / 2;
+            const int32_t dsty = posY * tileSize + tileSize / 2;
 
-                const fheroes2::Sprite & sprite = fheroes2::AGG::GetICN( icnPerZoomLevel[zoomLevelId], icnIndex );
-                fheroes2::Blit( sprite, cache.cachedImages[zoomLevelId], dstx - sprite.width() / 2, dsty - sprite.height() / 2 );
-                const fheroes2::Sprite & letter = fheroes2::AGG::GetICN( icnLetterPerZoomLevel[zoomLevelId], letterIndex );
-                fheroes2::Blit( letter, cache.cachedImages[zoomLevelId], dstx - letter.width() / 2, dsty - letter.height() / 2 );
-            }
+            const fheroes2::Sprite & sprite = fheroes2::AGG::GetICN( icnPerZoomLevel[zoomLevelId], icnIndex );
+            fheroes2::Blit( sprite, image, dstx - sprite.width() / 2, dsty - sprite.height() / 2 );
+            const fheroes2::Sprite & letter = fheroes2::AGG::GetICN( icnLetterPerZoomLevel[zoomLevelId], letterIndex );
+            fheroes2::Blit( letter, image, dstx - letter.width() / 2, dsty - letter.height() / 2 );
         };
 
         // There could be maximum 2 objects on the tile to analyze (in example: a Hero and a Castle).
@@ -627,9 +684,36 @@ void ViewWorld::ViewWorldWindow( const int32_t color, const ViewWorldMode mode,
 
     ZoomROIs currentROI( zoomLevel, viewCenterInPixels, visibleScreenInPixels );
 
-    CacheForMapWithResources cache( mode, gameArea );
+    worldMapCache.prepare( mode, color );
+
+#if defined( SAVE_WORLD_MAP )
+    worldMapCache.renderArea( 3, { 0, 0, world.w() * tileSizePerZoomLevel[3], world.h() * tileSizePerZoomLevel[3] }, gameArea );
+    fheroes2::Save( worldMapCache.getImage( 3 ), conf.getCurrentMapInfo().name + saveFilePrefix + ".bmp" );
+#endif
+
+    // The image of the current zoom level with icons of objects on top of the cached map.
+    fheroes2::Image worldImage;
+    worldImage._disableTransformLayer();
+    int32_t worldImageZoomLevelId = -1;
+
+    // Only the blocks of the map which are visible right now are rendered, icons are drawn again only when the cached map has been updated.
+    const auto updateWorldImage = [&worldImage, &worldImageZoomLevelId, &currentROI, &visibleScreenInPixels, &gameArea, color, mode]() {
+        const int32_t zoomLevelId = static_cast<uint8_t>( currentROI.getZoomLevel() );
+        const fheroes2::Point imageOffset = getImageOffset( currentROI );
+
+        const bool isMapUpdated
+            = worldMapCache.renderArea( zoomLevelId, { imageOffset.x, imageOffset.y, visibleScreenInPixels.width, visibleScreenInPixels.height }, gameArea );
+        if ( !isMapUpdated && zoomLevelId == worldImageZoomLevelId ) {
+            return;
+        }
+
+        fheroes2::Copy( worldMapCache.getImage( zoomLevelId ), worldImage );
+        DrawObjectsIcons( color, mode, zoomLevelId, worldImage );
+
+        worldImageZoomLevelId = zoomLevelId;
+    };
 
-    DrawObjectsIcons( color, mode, cache );
+    updateWorldImage();
 
     // We need to draw interface borders only if game interface is turned off on Adventure map.
     if ( isHideInterface ) {
@@ -660,7 +744,7 @@ void ViewWorld::ViewWorldWindow( const int32_t color, const ViewWorldMode mode,
     }
 
     // Render the View World map image.
-    DrawWorld( currentROI, cache, visibleScreenInPixels );
+    DrawWorld( currentROI, worldImage, visibleScreenInPixels );
 
     fheroes2::fadeInDisplay( fadeRoi, false );
 
@@ -713,7 +797,8 @@ void ViewWorld::ViewWorldWindow( const int32_t color, const ViewWorldMode mode,
         }
 
         if ( changed ) {
-            DrawWorld( currentROI, cache, visibleScreenInPixels );
+            updateWorldImage();
+            DrawWorld( currentROI, worldImage, visibleScreenInPixels );
             radar.RedrawForViewWorld( currentROI, mode, false );
             display.render();
         }
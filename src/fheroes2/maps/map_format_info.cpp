@@ -472,4 +472,32 @@ namespace Maps::Map_Format
 
         return saveToStream( fileStream, map );
     }
+
+    std::vector<uint8_t> saveMapDataWithoutTiles( const MapFormat & map )
+    {
+        RWStreamBuf stream;
+        stream.setBigendian( true );
+
+        saveToStream( stream, static_cast<const BaseMapFormat &>( map ) );
+
+        stream << map.additionalInfo << map.dailyEvents << map.rumors << map.standardMetadata << map.castleMetadata << map.heroMetadata << map.sphinxMetadata
+               << map.signMetadata << map.adventureMapEventMetadata << map.shrineMetadata;
+
+        return { stream.data(), stream.data() + stream.size() };
+    }
+
+    bool loadMapDataWithoutTiles( const std::vector<uint8_t> & data, MapFormat & map )
+    {
+        ROStreamBuf stream( data );
+        stream.setBigendian( true );
+
+        if ( !loadFromStream( stream, static_cast<BaseMapFormat &>( map ) ) ) {
+            return false;
+        }
+
+        stream >> map.additionalInfo >> map.dailyEvents >> map.rumors >> map.standardMetadata >> map.castleMetadata >> map.heroMetadata >> map.sphinxMetadata
+            >> map.signMetadata >> map.adventureMapEventMetadata >> map.shrineMetadata;
+
+        return !stream.fail();
+    }
 }
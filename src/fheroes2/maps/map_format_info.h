@@ -40,6 +40,16 @@ namespace Maps::Map_Format
         ObjectGroup group{ ObjectGroup::NONE };
 
         uint32_t index{ 0 };
+
+        bool operator==( const TileObjectInfo & anotherObject ) const
+        {
+            return id == anotherObject.id && group == anotherObject.group && index == anotherObject.index;
+        }
+
+        bool operator!=( const TileObjectInfo & anotherObject ) const
+        {
+            return !( *this == anotherObject );
+        }
     };
 
     struct TileInfo
@@ -48,6 +58,16 @@ namespace Maps::Map_Format
         uint8_t terrainFlag{ 0 };
 
         std::vector<TileObjectInfo> objects;
+
+        bool operator==( const TileInfo & anotherTile ) const
+        {
+            return terrainIndex == anotherTile.terrainIndex && terrainFlag == anotherTile.terrainFlag && objects == anotherTile.objects;
+        }
+
+        bool operator!=( const TileInfo & anotherTile ) const
+        {
+            return !( *this == anotherTile );
+        }
     };
 
     // This structure should be used for any object that require simple data to be saved into map.
@@ -335,4 +355,9 @@ namespace Maps::Map_Format
     bool loadMap( const std::string & path, MapFormat & map );
 
     bool saveMap( const std::string & path, const MapFormat & map );
+
+    // Serializes and deserializes all the map data except tiles. This is used to keep track of changes in the map properties and object metadata
+    // without copying the whole map.
+    std::vector<uint8_t> saveMapDataWithoutTiles( const MapFormat & map );
+    bool loadMapDataWithoutTiles( const std::vector<uint8_t> & data, MapFormat & map );
 }
@@ -715,6 +715,8 @@ void Maps::UpdateCastleSprite( const fheroes2::Point & center, int race, bool is
                 if ( addon && addon->_objectIcnType == MP2::OBJ_ICN_TYPE_OBJNTWRD ) {
                     addon->_objectIcnType = MP2::OBJ_ICN_TYPE_OBJNTOWN;
                     addon->_imageIndex = fullTownIndex - 16;
+
+                    world.markTileAppearanceChanged();
                 }
             }
         }
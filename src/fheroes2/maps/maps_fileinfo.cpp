@@ -24,6 +24,7 @@
 #include "maps_fileinfo.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstring>
 #include <functional>
@@ -32,6 +33,7 @@
 #include <locale>
 #include <map>
 #include <ostream>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
@@ -46,9 +48,11 @@
 #include "mp2.h"
 #include "mp2_helper.h"
 #include "race.h"
+#include "save_format_version.h"
 #include "serialize.h"
 #include "settings.h"
 #include "system.h"
+#include "timing.h"
 #include "tools.h"
 
 namespace
@@ -82,24 +86,297 @@ namespace
         return li == lhs.end() && ri != rhs.end();
     }
 
+    // Persistent cache of the map file headers. Each entry is identified by the path of the map file and remains valid as long
+    // as the size and the modification time of this file do not change. Invalid map files are cached as well so as not to parse
+    // them over and over again.
+    class MapInfoCache
+    {
+    public:
+        MapInfoCache() = default;
+        MapInfoCache( const MapInfoCache & ) = delete;
+
+        ~MapInfoCache() = default;
+
+        MapInfoCache & operator=( const MapInfoCache & ) = delete;
+
+        // Returns the info for each of the given map files in the same order. The map info is either taken from the cache or read
+        // from the map file if the file has been changed since it was cached. A null pointer is returned for invalid map files.
+        // Returned pointers remain valid until the next call of this method.
+        std::vector<const Maps::FileInfo *> getMapInfos( const ListFiles & mapFiles, const bool isOriginalMapFormat )
+        {
+            if ( !_isLoaded ) {
+                _isLoaded = true;
+
+                load();
+            }
+
+            const fheroes2::Time timer;
+
+            std::vector<const Maps::FileInfo *> result( mapFiles.size(), nullptr );
+
+            std::vector<std::pair<size_t, const std::string *>> misses;
+            std::vector<Entry> missedEntries;
+
+            size_t idx = 0;
+            for ( const std::string & mapFile : mapFiles ) {
+                Entry entry;
+                if ( !System::getFileSizeAndModificationTime( mapFile, entry.fileSize, entry.modificationTime ) ) {
+                    ++idx;
+                    continue;
+                }
+
+                const auto iter = _entries.find( mapFile );
+                if ( iter != _entries.end() && iter->second.fileSize == entry.fileSize && iter->second.modificationTime == entry.modificationTime ) {
+                    result[idx] = iter->second.isValid ? &iter->second.info : nullptr;
+                }
+                else {
+                    misses.emplace_back( idx, &mapFile );
+                    missedEntries.emplace_back( std::move( entry ) );
+                }
+
+                ++idx;
+            }
+
+            readMapInfos( misses, missedEntries, isOriginalMapFormat );
+
+            for ( size_t i = 0; i < misses.size(); ++i ) {
+                const auto [resultIdx, mapFile] = misses[i];
+
+                Entry & entry = _entries[*mapFile];
+                entry = std::move( missedEntries[i] );
+
+                result[resultIdx] = entry.isValid ? &entry.info : nullptr;
+            }
+
+            DEBUG_LOG( DBG_GAME, DBG_INFO,
+                       "Map files: " << mapFiles.size() << ", cached: " << mapFiles.size() - misses.size() << ", parsed: " << misses.size() << ", time: " << timer.getMs()
+                                     << " ms" )
+
+            if ( !misses.empty() ) {
+                save();
+            }
+
+            return result;
+        }
+
+    private:
+        struct Entry
+        {
+            uint64_t fileSize{ 0 };
+            int64_t modificationTime{ 0 };
+
+            bool isValid{ false };
+            Maps::FileInfo info;
+        };
+
+        static constexpr uint32_t cacheFileMagic{ 0x464D4943 };
+        static constexpr uint16_t cacheFileVersion{ 1 };
+
+        std::map<std::string, Entry, std::less<>> _entries;
+
+        bool _isLoaded{ false };
+
+        static std::string getCacheDirectory()
+        {
+            return System::concatPath( System::concatPath( System::GetDataDirectory( "fheroes2" ), "files" ), "cache" );
+        }
+
+        static std::string getCacheFilePath()
+        {
+            return System::concatPath( getCacheDirectory(), "maps.cache" );
+        }
+
+        static void put64( OStreamBase & stream, const uint64_t value )
+        {
+            stream.put32( static_cast<uint32_t>( value >> 32 ) );
+            stream.put32( static_cast<uint32_t>( value & 0xFFFFFFFF ) );
+        }
+
+        static uint64_t get64( IStreamBase & stream )
+        {
+            const uint64_t high = stream.get32();
+            const uint64_t low = stream.get32();
+
+            return ( high << 32 ) | low;
+        }
+
+        // Map files are parsed in parallel since there can be thousands of them
+        static void readMapInfos( const std::vector<std::pair<size_t, const std::string *>> & mapFiles, std::vector<Entry> & entries, const bool isOriginalMapFormat )
+        {
+            assert( mapFiles.size() == entries.size() );
+
+            std::atomic<size_t> nextIdx{ 0 };
+
+            const auto readMapInfo = [&mapFiles, &entries, &nextIdx, isOriginalMapFormat]() {
+                for ( size_t idx = nextIdx++; idx < mapFiles.size(); idx = nextIdx++ ) {
+                    const std::string & mapFile = *mapFiles[idx].second;
+                    Entry & entry = entries[idx];
+
+                    // The map info is always read as for the Editor, the filtering of the maps is done later
+                    if ( isOriginalMapFormat ) {
+                        entry.isValid = entry.info.readMP2Map( mapFile, true );
+                    }
+                    else {
+                        entry.isValid = entry.info.readResurrectionMap( mapFile, true );
+                    }
+                }
+            };
+
+            const size_t threadCount = std::min<size_t>( mapFiles.size(), std::max( std::thread::hardware_concurrency(), 1U ) );
+            if ( threadCount <= 1 ) {
+                readMapInfo();
+                return;
+            }
+
+            std::vector<std::thread> threads;
+            threads.reserve( threadCount - 1 );
+
+            for ( size_t i = 0; i + 1 < threadCount; ++i ) {
+                threads.emplace_back( readMapInfo );
+            }
+
+            readMapInfo();
+
+            for ( std::thread & thread : threads ) {
+                thread.join();
+            }
+        }
+
+        void load()
+        {
+            StreamFile fileStream;
+            fileStream.setBigendian( true );
+
+            const std::string cacheFilePath = getCacheFilePath();
+            if ( !System::IsFile( cacheFilePath ) || !fileStream.open( cacheFilePath, "rb" ) ) {
+                return;
+            }
+
+            if ( fileStream.get32() != cacheFileMagic || fileStream.get16() != cacheFileVersion || fileStream.get16() != CURRENT_FORMAT_VERSION ) {
+                DEBUG_LOG( DBG_GAME, DBG_INFO, "The map info cache " << cacheFilePath << " is outdated" )
+                return;
+            }
+
+            const uint32_t entryCount = fileStream.get32();
+
+            for ( uint32_t i = 0; i < entryCount; ++i ) {
+                std::string mapFile;
+                Entry entry;
+
+                fileStream >> mapFile;
+                entry.fileSize = get64( fileStream );
+                entry.modificationTime = static_cast<int64_t>( get64( fileStream ) );
+                fileStream >> entry.isValid;
+
+                if ( entry.isValid ) {
+                    fileStream >> entry.info;
+
+                    // Only the basename of the map file is serialized
+                    entry.info.filename = mapFile;
+                }
+
+                if ( fileStream.fail() ) {
+                    ERROR_LOG( "The map info cache " << cacheFilePath << " is corrupted" )
+
+                    _entries.clear();
+                    return;
+                }
+
+                _entries.insert_or_assign( std::move( mapFile ), std::move( entry ) );
+            }
+        }
+
+        void save()
+        {
+            // Forget the files that no longer exist
+            for ( auto iter = _entries.begin(); iter != _entries.end(); ) {
+                if ( System::IsFile( iter->first ) ) {
+                    ++iter;
+                }
+                else {
+                    iter = _entries.erase( iter );
+                }
+            }
+
+            const std::string cacheDirectory = getCacheDirectory();
+            if ( !System::IsDirectory( cacheDirectory ) && !System::MakeDirectory( cacheDirectory ) ) {
+                ERROR_LOG( "Unable to create a directory " << cacheDirectory )
+                return;
+            }
+
+            // The cache is written to a temporary file first so that a partially written cache is never used
+            const std::string cacheFilePath = getCacheFilePath();
+            const std::string tempFilePath = cacheFilePath + ".tmp";
+
+            {
+                StreamFile fileStream;
+                fileStream.setBigendian( true );
+
+                if ( !fileStream.open( tempFilePath, "wb" ) ) {
+                    return;
+                }
+
+                fileStream.put32( cacheFileMagic );
+                fileStream.put16( cacheFileVersion );
+                fileStream.put16( CURRENT_FORMAT_VERSION );
+                fileStream.put32( static_cast<uint32_t>( _entries.size() ) );
+
+                for ( const auto & [mapFile, entry] : _entries ) {
+                    fileStream << mapFile;
+                    put64( fileStream, entry.fileSize );
+                    put64( fileStream, static_cast<uint64_t>( entry.modificationTime ) );
+                    fileStream << entry.isValid;
+
+                    if ( entry.isValid ) {
+                        fileStream << entry.info;
+                    }
+                }
+
+                fileStream.close();
+
+                if ( fileStream.fail() ) {
+                    ERROR_LOG( "Failed to write the map info cache " << tempFilePath )
+
+                    System::Unlink( tempFilePath );
+                    return;
+                }
+            }
+
+            if ( !System::Rename( tempFilePath, cacheFilePath ) ) {
+                ERROR_LOG( "Failed to replace the map info cache " << cacheFilePath )
+
+                System::Unlink( tempFilePath );
+            }
+        }
+    };
+
+    MapInfoCache mapInfoCache;
+
     // This function returns an unsorted array. It is a caller responsibility to take care of sorting if needed.
     MapsFileInfoList getValidMaps( const ListFiles & mapFiles, const uint8_t humanPlayerCount, const bool isForEditor, const bool isOriginalMapFormat )
     {
         // create a list of unique maps (based on the map file name) and filter it by the preferred number of players
         std::map<std::string, Maps::FileInfo, std::less<>> uniqueMaps;
 
+        const std::vector<const Maps::FileInfo *> mapInfos = mapInfoCache.getMapInfos( mapFiles, isOriginalMapFormat );
+        assert( mapInfos.size() == mapFiles.size() );
+
+        size_t idx = 0;
         for ( const std::string & mapFile : mapFiles ) {
-            Maps::FileInfo fi;
+            const Maps::FileInfo * mapInfo = mapInfos[idx];
+            ++idx;
 
-            if ( isOriginalMapFormat ) {
-                if ( !fi.readMP2Map( mapFile, isForEditor ) ) {
-                    continue;
-                }
+            if ( mapInfo == nullptr ) {
+                continue;
             }
-            else {
-                if ( !fi.readResurrectionMap( mapFile, isForEditor ) ) {
-                    continue;
-                }
+
+            Maps::FileInfo fi = *mapInfo;
+            fi.filename = mapFile;
+
+            if ( !isForEditor && fi.colorsAvailableForHumans == 0 ) {
+                // This is not a valid map since no human players exist so it cannot be played.
+                DEBUG_LOG( DBG_GAME, DBG_WARN, "Map " << mapFile << " does not contain any human players." )
+                continue;
             }
 
             if ( !isForEditor ) {
@@ -318,10 +595,8 @@ bool Maps::FileInfo::readMP2Map( std::string filePath, const bool isForEditor )
         MP2::MP2TileInfo mp2tile;
         MP2::loadTile( fs, mp2tile );
 
-        Maps::Tiles tile;
-        tile.Init( 0, mp2tile );
-
-        const std::pair<int, int> colorRace = getColorRaceFromHeroSprite( tile.getMainObjectPart()._imageIndex );
+        // Map infos are read by several threads at once, so no Maps::Tiles object is initialized here since it would modify the state of the world.
+        const std::pair<int, int> colorRace = getColorRaceFromHeroSprite( Maps::Tiles::getMainObjectImageIndex( mp2tile ) );
         if ( ( colorRace.first & colorsAvailableForHumans ) == 0 ) {
             const int side1 = colorRace.first | colorsAvailableForHumans;
             const int side2 = colorsAvailableForComp ^ colorRace.first;
@@ -471,7 +471,7 @@ void Maps::Tiles::Init( int32_t index, const MP2::MP2TileInfo & mp2 )
         _isTileMarkedAsRoad = true;
     }
 
-    if ( mp2.mapObjectType == MP2::OBJ_NONE && ( layerType == ObjectLayerType::SHADOW_LAYER || layerType == ObjectLayerType::TERRAIN_LAYER ) ) {
+    if ( !isMainObjectInMP2Tile( mp2 ) ) {
         // If an object sits on shadow or terrain layer then we should put it as a bottom layer add-on.
         if ( bottomObjectIcnType != MP2::ObjectIcnType::OBJ_ICN_TYPE_UNKNOWN ) {
             _addonBottomLayer.emplace_back( layerType, mp2.level1ObjectUID, bottomObjectIcnType, mp2.bottomIcnImageIndex );
@@ -492,8 +492,22 @@ void Maps::Tiles::Init( int32_t index, const MP2::MP2TileInfo & mp2 )
     }
 }
 
+bool Maps::Tiles::isMainObjectInMP2Tile( const MP2::MP2TileInfo & mp2 )
+{
+    const uint8_t layerType = ( mp2.quantity1 & 0x03 );
+
+    return mp2.mapObjectType != MP2::OBJ_NONE || ( layerType != ObjectLayerType::SHADOW_LAYER && layerType != ObjectLayerType::TERRAIN_LAYER );
+}
+
+uint8_t Maps::Tiles::getMainObjectImageIndex( const MP2::MP2TileInfo & mp2 )
+{
+    return isMainObjectInMP2Tile( mp2 ) ? mp2.bottomIcnImageIndex : TilesAddon()._imageIndex;
+}
+
 void Maps::Tiles::setTerrain( const uint16_t terrainImageIndex, const bool horizontalFlip, const bool verticalFlip )
 {
+    world.markTileForRadarUpdate( _index );
+
     _terrainFlags = ( verticalFlip ? 1 : 0 ) + ( horizontalFlip ? 2 : 0 );
 
     const int newGround = Ground::getGroundByImageIndex( terrainImageIndex );
@@ -563,10 +577,13 @@ void Maps::Tiles::SetObject( const MP2::MapObjectType objectType )
     _mainObjectType = objectType;
 
     world.resetPathfinder();
+    world.markTileForRadarUpdate( _index );
 }
 
 void Maps::Tiles::setBoat( const int direction, const int color )
 {
+    world.markTileAppearanceChanged();
+
     if ( _mainAddon._objectIcnType != MP2::OBJ_ICN_TYPE_UNKNOWN ) {
         // It is important to preserve the order of objects for rendering purposes. Therefore, the main object should go to the front of objects.
         _addonBottomLayer.emplace_front( _mainAddon );
@@ -831,6 +848,8 @@ void Maps::Tiles::pushBottomLayerAddon( const MP2::MP2AddonInfo & ma )
     }
 
     _addonBottomLayer.emplace_back( static_cast<uint8_t>( ma.quantityN & 0x03 ), ma.level1ObjectUID, objectIcnType, ma.bottomIcnImageIndex );
+
+    world.markTileAppearanceChanged();
 }
 
 void Maps::Tiles::pushTopLayerAddon( const MP2::MP2AddonInfo & ma )
@@ -844,12 +863,19 @@ void Maps::Tiles::pushTopLayerAddon( const MP2::MP2AddonInfo & ma )
     // Top layer objects do not have any internal structure (layers) so all of them should have the same internal layer.
     // TODO: remove layer type for top layer objects.
     _addonTopLayer.emplace_back( OBJECT_LAYER, ma.level2ObjectUID, objectIcnType, ma.topIcnImageIndex );
+
+    world.markTileAppearanceChanged();
 }
 
 void Maps::Tiles::pushBottomLayerAddon( TilesAddon ta )
 {
     if ( isSpriteRoad( ta._objectIcnType, ta._imageIndex ) ) {
         _isTileMarkedAsRoad = true;
+
+        world.markTileForRadarUpdate( _index );
+    }
+    else {
+        world.markTileAppearanceChanged();
     }
 
     _addonBottomLayer.emplace_back( ta );
@@ -1230,6 +1256,8 @@ void Maps::Tiles::removeOwnershipFlag( const MP2::MapObjectType objectType )
 
 void Maps::Tiles::updateFlag( const int color, const uint8_t objectSpriteIndex, const uint32_t uid, const bool setOnUpperLayer )
 {
+    world.markTileForRadarUpdate( _index );
+
     // Flag deletion or installation must be done in relation to object UID as flag is attached to the object.
     if ( color == Color::NONE ) {
         const auto isFlag = [uid]( const auto & addon ) { return addon._uid == uid && addon._objectIcnType == MP2::OBJ_ICN_TYPE_FLAG32; };
@@ -1253,6 +1281,8 @@ void Maps::Tiles::updateFlag( const int color, const uint8_t objectSpriteIndex,
 
 void Maps::Tiles::_updateRoadFlag()
 {
+    world.markTileForRadarUpdate( _index );
+
     _isTileMarkedAsRoad = isSpriteRoad( _mainAddon._objectIcnType, _mainAddon._imageIndex );
 
     if ( _isTileMarkedAsRoad ) {
@@ -1465,6 +1495,8 @@ void Maps::Tiles::removeObjects( const MP2::ObjectIcnType objectIcnType )
 void Maps::Tiles::replaceObject( const uint32_t objectUid, const MP2::ObjectIcnType originalObjectIcnType, const MP2::ObjectIcnType newObjectIcnType,
                                  const uint8_t originalImageIndex, const uint8_t newImageIndex )
 {
+    world.markTileForRadarUpdate( _index );
+
     // We can immediately return from the function as only one object per tile can have the same UID.
     for ( auto & addon : _addonBottomLayer ) {
         if ( addon._uid == objectUid && addon._objectIcnType == originalObjectIcnType && addon._imageIndex == originalImageIndex ) {
@@ -1490,6 +1522,8 @@ void Maps::Tiles::replaceObject( const uint32_t objectUid, const MP2::ObjectIcnT
 
 void Maps::Tiles::updateObjectImageIndex( const uint32_t objectUid, const MP2::ObjectIcnType objectIcnType, const int imageIndexOffset )
 {
+    world.markTileForRadarUpdate( _index );
+
     // We can immediately return from the function as only one object per tile can have the same UID.
     for ( auto & addon : _addonBottomLayer ) {
         if ( addon._uid == objectUid && addon._objectIcnType == objectIcnType ) {
@@ -1515,6 +1549,10 @@ void Maps::Tiles::updateObjectImageIndex( const uint32_t objectUid, const MP2::O
 
 void Maps::Tiles::ClearFog( const int colors )
 {
+    if ( ( _fogColors & colors ) != 0 ) {
+        world.markTileForRadarUpdate( _index );
+    }
+
     _fogColors &= ~colors;
 
     // The fog might be cleared even without the hero's movement - for example, the hero can gain a new level of Scouting
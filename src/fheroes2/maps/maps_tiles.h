@@ -337,6 +337,12 @@ namespace Maps
         // Update tile or bottom layer object image index.
         static void updateTileObjectIcnIndex( Tiles & tile, const uint32_t uid, const uint8_t newIndex );
 
+        // Returns true if the bottom level object of the MP2 tile becomes the main object of the tile, otherwise it is put to the bottom layer add-ons.
+        static bool isMainObjectInMP2Tile( const MP2::MP2TileInfo & mp2 );
+
+        // Returns the image index of the main object the tile gets from the MP2 tile. It doesn't modify anything, so it can be called from any thread.
+        static uint8_t getMainObjectImageIndex( const MP2::MP2TileInfo & mp2 );
+
     private:
         bool isShadow() const;
 
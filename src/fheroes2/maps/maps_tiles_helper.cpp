@@ -2975,6 +2975,8 @@ namespace Maps
             }
         }
 
+        world.markTileAppearanceChanged();
+
         restoreMineObjectType( Direction::LEFT );
         restoreMineObjectType( Direction::RIGHT );
         restoreMineObjectType( Direction::TOP );
@@ -36,6 +36,7 @@
 #include <utility>
 
 #include "agg_image.h"
+#include "army.h"
 #include "dialog.h"
 #include "dialog_selectitems.h"
 #include "gamedefs.h"
@@ -847,6 +848,8 @@ bool BagArtifacts::PushArtifact( const Artifact & art )
     if ( art.GetID() != Artifact::MAGIC_BOOK ) {
         *firstEmptySlotIter = art;
 
+        Army::invalidateStrengthCache();
+
         return true;
     }
 
@@ -856,6 +859,8 @@ bool BagArtifacts::PushArtifact( const Artifact & art )
     // ... and then put the Magic Book to the first slot of the artifact bag.
     front() = art;
 
+    Army::invalidateStrengthCache();
+
     return true;
 }
 
@@ -867,6 +872,8 @@ void BagArtifacts::RemoveArtifact( const Artifact & art )
     }
 
     it->Reset();
+
+    Army::invalidateStrengthCache();
 }
 
 bool BagArtifacts::isFull() const
@@ -893,6 +900,8 @@ double BagArtifacts::getArtifactValue() const
 
 void BagArtifacts::exchangeArtifacts( BagArtifacts & giftBag, const Heroes & taker, const Heroes & giver )
 {
+    Army::invalidateStrengthCache();
+
     std::vector<Artifact> combined;
     for ( auto it = begin(); it != end(); ++it ) {
         if ( it->isValid() && it->GetID() != Artifact::MAGIC_BOOK ) {
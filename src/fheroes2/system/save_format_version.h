@@ -27,6 +27,8 @@ enum SaveFileFormat : uint16_t
     // !!! IMPORTANT !!!
     // If you're adding a new version you must assign it to CURRENT_FORMAT_VERSION located at the bottom.
     // If you're removing an old version you must assign the oldest available to LAST_SUPPORTED_FORMAT_VERSION located at the bottom.
+    FORMAT_VERSION_PRE2_1102_RELEASE = 10023,
+    FORMAT_VERSION_PRE1_1102_RELEASE = 10022,
     FORMAT_VERSION_1101_RELEASE = 10021,
     FORMAT_VERSION_PRE1_1101_RELEASE = 10020,
     FORMAT_VERSION_1100_RELEASE = 10019,
@@ -42,5 +44,5 @@ enum SaveFileFormat : uint16_t
 
     LAST_SUPPORTED_FORMAT_VERSION = FORMAT_VERSION_1005_RELEASE,
 
-    CURRENT_FORMAT_VERSION = FORMAT_VERSION_1101_RELEASE
+    CURRENT_FORMAT_VERSION = FORMAT_VERSION_PRE2_1102_RELEASE
 };
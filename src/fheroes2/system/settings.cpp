@@ -80,7 +80,8 @@ namespace
         GAME_BATTLE_AUTO_RESOLVE = 0x04000000,
         GAME_BATTLE_AUTO_SPELLCAST = 0x08000000,
         GAME_AUTO_SAVE_AT_BEGINNING_OF_TURN = 0x10000000,
-        GAME_SCREEN_SCALING_TYPE_NEAREST = 0x20000000
+        GAME_SCREEN_SCALING_TYPE_NEAREST = 0x20000000,
+        GAME_DELTA_SAVES = 0x40000000
     };
 
     enum EditorOptions : uint32_t
@@ -317,6 +318,10 @@ bool Settings::Read( const std::string & filePath )
         setAutoSaveAtBeginningOfTurn( config.StrParams( "auto save at the beginning of the turn" ) == "on" );
     }
 
+    if ( config.Exists( "delta saves" ) ) {
+        setDeltaSave( config.StrParams( "delta saves" ) == "on" );
+    }
+
     if ( config.Exists( "cursor soft rendering" ) ) {
         if ( config.StrParams( "cursor soft rendering" ) == "on" ) {
             _gameOptions.SetModes( GAME_CURSOR_SOFT_EMULATION );
@@ -481,6 +486,10 @@ std::string Settings::String() const
     os << std::endl << "# should auto save be performed at the beginning of the turn instead of the end of the turn: on/off" << std::endl;
     os << "auto save at the beginning of the turn = " << ( _gameOptions.Modes( GAME_AUTO_SAVE_AT_BEGINNING_OF_TURN ) ? "on" : "off" ) << std::endl;
 
+    os << std::endl << "# save only the map tiles that have changed since the beginning of the game, their initial state is kept in a separate file: on/off"
+       << std::endl;
+    os << "delta saves = " << ( _gameOptions.Modes( GAME_DELTA_SAVES ) ? "on" : "off" ) << std::endl;
+
     os << std::endl << "# enable cursor software rendering" << std::endl;
     os << "cursor soft rendering = " << ( _gameOptions.Modes( GAME_CURSOR_SOFT_EMULATION ) ? "on" : "off" ) << std::endl;
 
@@ -787,6 +796,16 @@ void Settings::setAutoSaveAtBeginningOfTurn( const bool enable )
     }
 }
 
+void Settings::setDeltaSave( const bool enable )
+{
+    if ( enable ) {
+        _gameOptions.SetModes( GAME_DELTA_SAVES );
+    }
+    else {
+        _gameOptions.ResetModes( GAME_DELTA_SAVES );
+    }
+}
+
 void Settings::setBattleDamageInfo( const bool enable )
 {
     if ( enable ) {
@@ -864,6 +883,11 @@ bool Settings::isAutoSaveAtBeginningOfTurnEnabled() const
     return _gameOptions.Modes( GAME_AUTO_SAVE_AT_BEGINNING_OF_TURN );
 }
 
+bool Settings::isDeltaSaveEnabled() const
+{
+    return _gameOptions.Modes( GAME_DELTA_SAVES );
+}
+
 bool Settings::isBattleShowDamageInfoEnabled() const
 {
     return _gameOptions.Modes( GAME_BATTLE_SHOW_DAMAGE );
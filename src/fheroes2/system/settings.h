@@ -186,6 +186,7 @@ public:
     bool is3DAudioEnabled() const;
     bool isSystemInfoEnabled() const;
     bool isAutoSaveAtBeginningOfTurnEnabled() const;
+    bool isDeltaSaveEnabled() const;
     bool isBattleShowDamageInfoEnabled() const;
     bool isHideInterfaceEnabled() const;
     bool isEvilInterfaceEnabled() const;
@@ -249,6 +250,7 @@ public:
     void setVSync( const bool enable );
     void setSystemInfo( const bool enable );
     void setAutoSaveAtBeginningOfTurn( const bool enable );
+    void setDeltaSave( const bool enable );
     void setBattleDamageInfo( const bool enable );
     void setHideInterface( const bool enable );
     void setEvilInterface( const bool enable );
@@ -25,10 +25,12 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <limits>
 #include <ostream>
 #include <set>
+#include <thread>
 #include <tuple>
 #include <utility>
 
@@ -59,6 +61,7 @@
 #include "save_format_version.h"
 #include "serialize.h"
 #include "settings.h"
+#include "timing.h"
 #include "tools.h"
 #include "translations.h"
 #include "week.h"
@@ -349,6 +352,10 @@ void World::Reset()
     heroIdAsLossCondition = Heroes::UNKNOWN;
 
     _seed = 0;
+
+    _baseTiles.reset();
+
+    markAllTilesForRadarUpdate();
 }
 
 void World::generateBattleOnlyMap()
@@ -882,6 +889,10 @@ void World::CaptureObject( int32_t index, int color )
     if ( color & ( Color::ALL | Color::UNUSED ) ) {
         GetTiles( index ).setOwnershipFlag( objectType, color );
     }
+
+    // All parts of the object are painted in the color of its owner on the radar. The main tile of an object is located at its bottom.
+    const fheroes2::Point position = Maps::GetPoint( index );
+    markAreaForRadarUpdate( { position.x - 3, position.y - 3, 7, 5 } );
 }
 
 int World::ColorCapturedObject( int32_t index ) const
@@ -897,6 +908,8 @@ CapturedObject & World::GetCapturedObject( int32_t index )
 void World::ResetCapturedObjects( int color )
 {
     map_captureobj.ResetColor( color );
+
+    markAllTilesForRadarUpdate();
 }
 
 void World::ClearFog( int colors )
@@ -1284,31 +1297,158 @@ std::list<Route::Step> World::getPath( const Heroes & hero, int targetIndex )
 
 void World::resetPathfinder()
 {
+    if ( _isParallelTileProcessingInProgress ) {
+        return;
+    }
+
     _pathfinder.reset();
     AI::Planner::Get().resetPathfinder();
 }
 
-void World::updatePassabilities()
+void World::markTileForRadarUpdate( const int32_t tileIndex )
 {
-    for ( Maps::Tiles & tile : vec_tiles ) {
-        // If tile is empty then update tile's object type if needed.
-        if ( tile.isSameMainObject( MP2::OBJ_NONE ) ) {
-            tile.updateObjectType();
+    if ( _isParallelTileProcessingInProgress ) {
+        return;
+    }
+
+    ++_tilesGeneration;
+
+    if ( _isFullRadarUpdateNeeded ) {
+        return;
+    }
+
+    _radarTilesToUpdate.insert( tileIndex );
+
+    // It is faster to update the whole radar than to process a large number of separate tiles.
+    if ( _radarTilesToUpdate.size() > vec_tiles.size() / 4 ) {
+        markAllTilesForRadarUpdate();
+    }
+}
+
+void World::markAreaForRadarUpdate( const fheroes2::Rect & area )
+{
+    const fheroes2::Rect roi = area ^ fheroes2::Rect( 0, 0, width, height );
+
+    for ( int32_t y = roi.y; y < roi.y + roi.height; ++y ) {
+        for ( int32_t x = roi.x; x < roi.x + roi.width; ++x ) {
+            markTileForRadarUpdate( y * width + x );
         }
+    }
+}
+
+void World::markAllTilesForRadarUpdate()
+{
+    _radarTilesToUpdate.clear();
+    _isFullRadarUpdateNeeded = true;
+
+    ++_tilesGeneration;
+}
 
-        tile.setInitialPassability();
+void World::markTileAppearanceChanged()
+{
+    // All tiles are marked for an update once the parallel processing is over.
+    if ( _isParallelTileProcessingInProgress ) {
+        return;
     }
 
+    ++_tilesGeneration;
+}
+
+bool World::takeTilesForRadarUpdate( std::set<int32_t> & tileIndexes )
+{
+    const bool isPartialUpdate = !_isFullRadarUpdateNeeded;
+
+    if ( isPartialUpdate ) {
+        tileIndexes.insert( _radarTilesToUpdate.begin(), _radarTilesToUpdate.end() );
+    }
+
+    _radarTilesToUpdate.clear();
+    _isFullRadarUpdateNeeded = false;
+
+    return isPartialUpdate;
+}
+
+void World::updatePassabilities()
+{
+    // The object type and the initial passability of a tile depend only on the tile itself and the terrain of its neighbours.
+    processTilesInParallel( [this]( const int32_t begin, const int32_t end ) {
+        for ( int32_t i = begin; i < end; ++i ) {
+            Maps::Tiles & tile = vec_tiles[i];
+
+            // If tile is empty then update tile's object type if needed.
+            if ( tile.isSameMainObject( MP2::OBJ_NONE ) ) {
+                tile.updateObjectType();
+            }
+
+            tile.setInitialPassability();
+        }
+    } );
+
     // Once the original passabilities are set we know all neighbours. Now we have to update passabilities based on neighbours.
-    for ( Maps::Tiles & tile : vec_tiles ) {
-        tile.updatePassability();
+    // Only objects of neighbouring tiles are taken into account, so tiles can be processed in any order.
+    processTilesInParallel( [this]( const int32_t begin, const int32_t end ) {
+        for ( int32_t i = begin; i < end; ++i ) {
+            vec_tiles[i].updatePassability();
+        }
+    } );
+}
+
+void World::processTilesInParallel( const std::function<void( const int32_t, const int32_t )> & processTiles )
+{
+    const int32_t tileCount = static_cast<int32_t>( vec_tiles.size() );
+
+    // Tiles are split into ranges which are big enough to make the overhead of synchronization negligible.
+    const int32_t rangeSize = 1024;
+    const int32_t rangeCount = ( tileCount + rangeSize - 1 ) / rangeSize;
+
+    const int32_t threadCount = std::min( rangeCount, static_cast<int32_t>( std::max( std::thread::hardware_concurrency(), 1U ) ) );
+    if ( threadCount <= 1 ) {
+        processTiles( 0, tileCount );
+        return;
+    }
+
+    _isParallelTileProcessingInProgress = true;
+
+    std::atomic<int32_t> nextRangeId{ 0 };
+
+    const auto processRanges = [&processTiles, &nextRangeId, tileCount, rangeCount]() {
+        for ( int32_t rangeId = nextRangeId++; rangeId < rangeCount; rangeId = nextRangeId++ ) {
+            processTiles( rangeId * rangeSize, std::min( ( rangeId + 1 ) * rangeSize, tileCount ) );
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve( threadCount - 1 );
+
+    for ( int32_t i = 0; i + 1 < threadCount; ++i ) {
+        threads.emplace_back( processRanges );
     }
+
+    processRanges();
+
+    for ( std::thread & thread : threads ) {
+        thread.join();
+    }
+
+    _isParallelTileProcessingInProgress = false;
+
+    resetPathfinder();
+    markAllTilesForRadarUpdate();
 }
 
 void World::PostLoad( const bool setTilePassabilities )
 {
+    fheroes2::Time timer;
+
+    // All tiles have been replaced.
+    markAllTilesForRadarUpdate();
+
     if ( setTilePassabilities ) {
         updatePassabilities();
+
+        DEBUG_LOG( DBG_GAME, DBG_INFO, "Updated passabilities of tiles in " << timer.getMs() << " ms" )
+
+        timer.reset();
     }
 
     // Cache all tiles that that contain stone liths of a certain type (depending on object sprite index).
@@ -1327,6 +1467,27 @@ void World::PostLoad( const bool setTilePassabilities )
 
     resetPathfinder();
     ComputeStaticAnalysis();
+
+    DEBUG_LOG( DBG_GAME, DBG_INFO, "Computed regions of the map in " << timer.getMs() << " ms" )
+}
+
+void World::prepareDeltaSave()
+{
+    if ( !Settings::Get().isDeltaSaveEnabled() ) {
+        return;
+    }
+
+    // The base tiles are captured only when they are needed for the first time, so games without delta saves don't pay for them
+    if ( !_baseTiles.isValid() ) {
+        _baseTiles.capture( vec_tiles, _seed );
+    }
+
+    _baseTiles.store();
+}
+
+bool World::isDeltaSaveAvailable() const
+{
+    return Settings::Get().isDeltaSaveEnabled() && _baseTiles.isStored();
 }
 
 uint32_t World::GetMapSeed() const
@@ -1441,41 +1602,120 @@ IStreamBase & operator>>( IStreamBase & stream, MapObjects & objs )
     return stream;
 }
 
-OStreamBase & operator<<( OStreamBase & stream, const World & w )
+void World::writeSaveSection( OStreamBase & stream, const SaveSection section ) const
 {
-    return stream << w.width << w.height << w.vec_tiles << w.vec_heroes << w.vec_castles << w.vec_kingdoms << w._customRumors << w.vec_eventsday << w.map_captureobj
-                  << w.ultimate_artifact << w.day << w.week << w.month << w.heroIdAsWinCondition << w.heroIdAsLossCondition << w.map_objects << w._seed;
+    switch ( section ) {
+    case SaveSection::TILES: {
+        stream << width << height;
+
+        const bool isDeltaSave = isDeltaSaveAvailable();
+        stream << isDeltaSave;
+
+        if ( isDeltaSave ) {
+            _baseTiles.writeChangedTiles( stream, vec_tiles );
+        }
+        else {
+            stream << vec_tiles;
+        }
+        break;
+    }
+    case SaveSection::HEROES:
+        stream << vec_heroes;
+        break;
+    case SaveSection::CASTLES:
+        stream << vec_castles;
+        break;
+    case SaveSection::KINGDOMS:
+        stream << vec_kingdoms;
+        break;
+    case SaveSection::STATE:
+        stream << _customRumors << vec_eventsday << map_captureobj << ultimate_artifact << day << week << month << heroIdAsWinCondition << heroIdAsLossCondition
+               << map_objects << _seed;
+        break;
+    default:
+        // Did you add a new section?
+        assert( 0 );
+        break;
+    }
 }
 
-IStreamBase & operator>>( IStreamBase & stream, World & w )
+bool World::readSaveSection( IStreamBase & stream, const SaveSection section )
 {
-    static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_1010_RELEASE, "Remove the logic below." );
-    if ( Game::GetVersionOfCurrentSaveFile() < FORMAT_VERSION_1010_RELEASE ) {
-        uint16_t width = 0;
-        uint16_t height = 0;
+    switch ( section ) {
+    case SaveSection::TILES: {
+        static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_1010_RELEASE, "Remove the logic below." );
+        if ( Game::GetVersionOfCurrentSaveFile() < FORMAT_VERSION_1010_RELEASE ) {
+            uint16_t oldWidth = 0;
+            uint16_t oldHeight = 0;
 
-        stream >> width >> height;
-        w.width = width;
-        w.height = height;
-    }
-    else {
-        stream >> w.width >> w.height;
+            stream >> oldWidth >> oldHeight;
+            width = oldWidth;
+            height = oldHeight;
+        }
+        else {
+            stream >> width >> height;
+        }
+
+        bool isDeltaSave = false;
+
+        if ( Game::GetVersionOfCurrentSaveFile() >= FORMAT_VERSION_PRE1_1102_RELEASE ) {
+            stream >> isDeltaSave;
+        }
+
+        if ( isDeltaSave ) {
+            // The base tiles have to be loaded in advance
+            if ( !_baseTiles.readChangedTiles( stream, vec_tiles ) ) {
+                ERROR_LOG( "Failed to restore the map tiles" )
+                return false;
+            }
+        }
+        else {
+            stream >> vec_tiles;
+
+            _baseTiles.reset();
+        }
+        break;
     }
+    case SaveSection::HEROES:
+        stream >> vec_heroes;
+        break;
+    case SaveSection::CASTLES:
+        stream >> vec_castles;
+        break;
+    case SaveSection::KINGDOMS:
+        stream >> vec_kingdoms;
+        break;
+    case SaveSection::STATE:
+        stream >> _customRumors >> vec_eventsday >> map_captureobj >> ultimate_artifact >> day >> week >> month >> heroIdAsWinCondition >> heroIdAsLossCondition;
 
-    stream >> w.vec_tiles >> w.vec_heroes >> w.vec_castles >> w.vec_kingdoms >> w._customRumors >> w.vec_eventsday >> w.map_captureobj >> w.ultimate_artifact >> w.day
-        >> w.week >> w.month >> w.heroIdAsWinCondition >> w.heroIdAsLossCondition;
+        static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_1010_RELEASE, "Remove the logic below." );
+        if ( Game::GetVersionOfCurrentSaveFile() < FORMAT_VERSION_1010_RELEASE ) {
+            ++heroIdAsWinCondition;
+            ++heroIdAsLossCondition;
+        }
 
-    static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_1010_RELEASE, "Remove the logic below." );
-    if ( Game::GetVersionOfCurrentSaveFile() < FORMAT_VERSION_1010_RELEASE ) {
-        ++w.heroIdAsWinCondition;
-        ++w.heroIdAsLossCondition;
+        stream >> map_objects >> _seed;
+        break;
+    default:
+        // Did you add a new section?
+        assert( 0 );
+        return false;
     }
 
-    stream >> w.map_objects >> w._seed;
+    return !stream.fail();
+}
+
+bool World::readLegacySave( IStreamBase & stream )
+{
+    for ( const SaveSection section : { SaveSection::TILES, SaveSection::HEROES, SaveSection::CASTLES, SaveSection::KINGDOMS, SaveSection::STATE } ) {
+        if ( !readSaveSection( stream, section ) ) {
+            return false;
+        }
+    }
 
-    w.PostLoad( false );
+    PostLoad( false );
 
-    return stream;
+    return true;
 }
 
 void EventDate::LoadFromMP2( const std::vector<uint8_t> & data )
@@ -25,8 +25,10 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <list>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -41,6 +43,7 @@
 #include "monster.h"
 #include "pairs.h"
 #include "resource.h"
+#include "world_base_tiles.h"
 #include "world_pathfinding.h"
 #include "world_regions.h"
 
@@ -369,6 +372,24 @@ public:
     std::list<Route::Step> getPath( const Heroes & hero, int targetIndex );
     void resetPathfinder();
 
+    // Tiles whose appearance on the radar might have been changed (fog, object, terrain or the color of the owner) are collected here,
+    // so the radar is updated only in these tiles instead of the whole map. Every such change also increases the tiles generation.
+    void markTileForRadarUpdate( const int32_t tileIndex );
+    void markAreaForRadarUpdate( const fheroes2::Rect & area );
+    void markAllTilesForRadarUpdate();
+
+    // Only increases the tiles generation. Used when a tile looks different but its radar color remains the same, e.g. a new part of an object was added on top.
+    void markTileAppearanceChanged();
+
+    // Moves the indexes of the tiles marked since the last call to the given set. Returns false if the whole radar has to be updated.
+    bool takeTilesForRadarUpdate( std::set<int32_t> & tileIndexes );
+
+    // Increased every time the appearance of any tile might have been changed. Images rendered from the map remain valid until it changes.
+    uint32_t getTilesGeneration() const
+    {
+        return _tilesGeneration;
+    }
+
     void ComputeStaticAnalysis();
 
     uint32_t GetMapSeed() const;
@@ -378,6 +399,48 @@ public:
 
     void updatePassabilities();
 
+    // Delta saves contain only the tiles that differ from their state at the time of the first delta save of the game (see WorldBaseTiles).
+    // This method captures this state and writes it to the disk if delta saves are enabled and it hasn't been done yet.
+    void prepareDeltaSave();
+
+    bool isDeltaSaveAvailable() const;
+
+    const WorldBaseTiles & getBaseTiles() const
+    {
+        return _baseTiles;
+    }
+
+    // Should be called before loading a delta save
+    bool loadBaseTiles( const uint32_t mapSeed, const uint32_t checksum )
+    {
+        return _baseTiles.load( mapSeed, checksum );
+    }
+
+    // Parts of the world which are stored in separate sections of a save file. Together they contain the same data as the serialized world.
+    enum class SaveSection : uint8_t
+    {
+        TILES,
+        HEROES,
+        CASTLES,
+        KINGDOMS,
+        // Everything else: events, captured objects, date, map objects and so on.
+        STATE
+    };
+
+    void writeSaveSection( OStreamBase & stream, const SaveSection section ) const;
+
+    // All sections have to be read in the order of their declaration, then completeLoadingFromSave() must be called.
+    // Returns false if the section could not be read, in which case the world is left in an invalid state.
+    bool readSaveSection( IStreamBase & stream, const SaveSection section );
+
+    void completeLoadingFromSave()
+    {
+        PostLoad( false );
+    }
+
+    // Save files prior to FORMAT_VERSION_PRE2_1102_RELEASE store all sections in a row. Returns false in case of failure.
+    bool readLegacySave( IStreamBase & stream );
+
 private:
     World() = default;
 
@@ -397,9 +460,11 @@ private:
 
     void setHeroIdsForMapConditions();
 
+    // Calls the given function for ranges of tiles [begin, end) in multiple threads. The function may change only the tiles within the given range
+    // and must not read any data of other tiles that is being changed at the same time. The pathfinder is reset once all tiles are processed.
+    void processTilesInParallel( const std::function<void( const int32_t, const int32_t )> & processTiles );
+
     friend class Radar;
-    friend OStreamBase & operator<<( OStreamBase & stream, const World & w );
-    friend IStreamBase & operator>>( IStreamBase & stream, World & w );
 
     std::vector<Maps::Tiles> vec_tiles;
     AllHeroes vec_heroes;
@@ -433,6 +498,15 @@ private:
     double _landRoughness{ 1.0 };
     std::vector<MapRegion> _regions;
     PlayerWorldPathfinder _pathfinder;
+    WorldBaseTiles _baseTiles;
+
+    std::set<int32_t> _radarTilesToUpdate;
+    bool _isFullRadarUpdateNeeded{ true };
+    uint32_t _tilesGeneration{ 0 };
+
+    // Set while tiles are processed by several threads at once. Tiles reset the pathfinder, mark themselves for the radar update and increase
+    // the tiles generation on every change, which is not thread-safe. All of this is done once for the whole map when the processing is over.
+    bool _isParallelTileProcessingInProgress{ false };
 };
 
 OStreamBase & operator<<( OStreamBase & stream, const CapturedObject & obj );
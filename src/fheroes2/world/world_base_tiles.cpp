@@ -0,0 +1,331 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2024                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "world_base_tiles.h"
+
+#include <algorithm>
+#include <cassert>
+#include <ostream>
+#include <utility>
+
+#include "dir.h"
+#include "game_io.h"
+#include "logging.h"
+#include "maps_tiles.h"
+#include "serialize.h"
+#include "system.h"
+#include "tools.h"
+#include "zzlib.h"
+
+namespace
+{
+    const uint32_t baseTilesFileMagic = 0x46484254;
+
+    std::string getBaseTilesDirectory()
+    {
+        return System::concatPath( Game::GetSaveDir(), "base" );
+    }
+}
+
+void WorldBaseTiles::capture( const std::vector<Maps::Tiles> & tiles, const uint32_t mapSeed )
+{
+    reset();
+
+    RWStreamBuf stream;
+    stream.setBigendian( true );
+
+    _offsets.reserve( tiles.size() + 1 );
+
+    for ( const Maps::Tiles & tile : tiles ) {
+        _offsets.push_back( stream.size() );
+        stream << tile;
+    }
+
+    _offsets.push_back( stream.size() );
+
+    _data.assign( stream.data(), stream.data() + stream.size() );
+    _mapSeed = mapSeed;
+    _checksum = fheroes2::calculateCRC32( _data.data(), _data.size() );
+    _formatVersion = CURRENT_FORMAT_VERSION;
+}
+
+void WorldBaseTiles::reset()
+{
+    _data.clear();
+    _offsets.clear();
+    _mapSeed = 0;
+    _checksum = 0;
+    _formatVersion = CURRENT_FORMAT_VERSION;
+    _isStored = false;
+}
+
+bool WorldBaseTiles::store()
+{
+    if ( _isStored ) {
+        return true;
+    }
+
+    if ( !isValid() ) {
+        return false;
+    }
+
+    const std::string directory = getBaseTilesDirectory();
+    if ( !System::IsDirectory( directory ) && !System::MakeDirectory( directory ) ) {
+        ERROR_LOG( "Unable to create a directory " << directory )
+        return false;
+    }
+
+    const std::string filePath = getFilePath();
+    const std::string tempFilePath = filePath + ".tmp";
+
+    bool isWritten = false;
+
+    {
+        StreamFile fileStream;
+        fileStream.setBigendian( true );
+
+        if ( fileStream.open( tempFilePath, "wb" ) ) {
+            fileStream << baseTilesFileMagic << _formatVersion << _mapSeed << _checksum << static_cast<uint32_t>( _offsets.size() - 1 );
+
+            Compression::ZipFileOStream zipStream( fileStream );
+            zipStream.setBigendian( true );
+
+            zipStream << _data;
+
+            isWritten = !fileStream.fail() && zipStream.finalize();
+        }
+    }
+
+    if ( !isWritten || !System::Rename( tempFilePath, filePath ) ) {
+        ERROR_LOG( "Failed to write the file " << filePath )
+
+        System::Unlink( tempFilePath );
+
+        return false;
+    }
+
+    DEBUG_LOG( DBG_GAME, DBG_INFO, "Base tiles have been written to " << filePath )
+
+    _isStored = true;
+
+    return true;
+}
+
+bool WorldBaseTiles::load( const uint32_t mapSeed, const uint32_t checksum )
+{
+    if ( isValid() && _mapSeed == mapSeed && _checksum == checksum ) {
+        return true;
+    }
+
+    reset();
+
+    _mapSeed = mapSeed;
+    _checksum = checksum;
+
+    const std::string filePath = getFilePath();
+
+    StreamFile fileStream;
+    fileStream.setBigendian( true );
+
+    if ( !fileStream.open( filePath, "rb" ) ) {
+        ERROR_LOG( "Error opening the file " << filePath )
+
+        reset();
+        return false;
+    }
+
+    uint32_t magic = 0;
+    uint16_t formatVersion = 0;
+    uint32_t fileMapSeed = 0;
+    uint32_t fileChecksum = 0;
+    uint32_t tileCount = 0;
+
+    fileStream >> magic >> formatVersion >> fileMapSeed >> fileChecksum >> tileCount;
+
+    if ( fileStream.fail() || magic != baseTilesFileMagic || formatVersion > CURRENT_FORMAT_VERSION || formatVersion < LAST_SUPPORTED_FORMAT_VERSION
+         || fileMapSeed != mapSeed || fileChecksum != checksum ) {
+        ERROR_LOG( "Invalid format of the file " << filePath )
+
+        reset();
+        return false;
+    }
+
+    Compression::UnzipIStream zipStream( fileStream );
+    zipStream.setBigendian( true );
+
+    zipStream >> _data;
+
+    if ( zipStream.fail() || fheroes2::calculateCRC32( _data.data(), _data.size() ) != checksum ) {
+        ERROR_LOG( "The file " << filePath << " is corrupted" )
+
+        reset();
+        return false;
+    }
+
+    _formatVersion = formatVersion;
+
+    // Find out where every tile starts
+    ROStreamBuf dataStream( _data );
+    dataStream.setBigendian( true );
+
+    // Tiles are serialized in the save file format, so its version should be set accordingly
+    const uint16_t currentSaveFileVersion = Game::GetVersionOfCurrentSaveFile();
+    Game::SetVersionOfCurrentSaveFile( _formatVersion );
+
+    _offsets.reserve( static_cast<size_t>( tileCount ) + 1 );
+
+    for ( uint32_t i = 0; i < tileCount && !dataStream.fail(); ++i ) {
+        _offsets.push_back( dataStream.tell() );
+
+        Maps::Tiles tile;
+        dataStream >> tile;
+    }
+
+    _offsets.push_back( dataStream.tell() );
+
+    Game::SetVersionOfCurrentSaveFile( currentSaveFileVersion );
+
+    if ( dataStream.fail() || _offsets.back() != _data.size() ) {
+        ERROR_LOG( "The file " << filePath << " is corrupted" )
+
+        reset();
+        return false;
+    }
+
+    _isStored = true;
+
+    return true;
+}
+
+void WorldBaseTiles::writeChangedTiles( OStreamBase & stream, const std::vector<Maps::Tiles> & tiles ) const
+{
+    assert( isValid() );
+
+    const bool isSameMap = ( tiles.size() + 1 == _offsets.size() );
+
+    // Tiles are serialized to a temporary buffer to be compared with the base ones
+    RWStreamBuf tilesStream;
+    tilesStream.setBigendian( stream.bigendian() );
+
+    std::vector<std::pair<size_t, size_t>> changedTiles;
+
+    for ( size_t i = 0; i < tiles.size(); ++i ) {
+        const size_t offset = tilesStream.size();
+        tilesStream << tiles[i];
+        const size_t size = tilesStream.size() - offset;
+
+        const uint8_t * tileData = tilesStream.data() + offset;
+
+        if ( isSameMap && size == _offsets[i + 1] - _offsets[i] && std::equal( tileData, tileData + size, _data.data() + _offsets[i] ) ) {
+            continue;
+        }
+
+        changedTiles.emplace_back( offset, size );
+    }
+
+    DEBUG_LOG( DBG_GAME, DBG_INFO, changedTiles.size() << " of " << tiles.size() << " tiles differ from the base ones" )
+
+    stream << _mapSeed << _checksum << static_cast<uint32_t>( tiles.size() ) << static_cast<uint32_t>( changedTiles.size() );
+
+    for ( const auto & [offset, size] : changedTiles ) {
+        stream.putRaw( tilesStream.data() + offset, size );
+    }
+}
+
+bool WorldBaseTiles::readChangedTiles( IStreamBase & stream, std::vector<Maps::Tiles> & tiles )
+{
+    uint32_t mapSeed = 0;
+    uint32_t checksum = 0;
+    uint32_t tileCount = 0;
+    uint32_t changedTileCount = 0;
+
+    stream >> mapSeed >> checksum >> tileCount >> changedTileCount;
+
+    if ( stream.fail() || !isValid() || mapSeed != _mapSeed || checksum != _checksum || static_cast<size_t>( tileCount ) + 1 != _offsets.size() ) {
+        ERROR_LOG( "The base tiles do not match the save file" )
+        return false;
+    }
+
+    tiles.clear();
+    tiles.resize( tileCount );
+
+    {
+        ROStreamBuf dataStream( _data );
+        dataStream.setBigendian( true );
+
+        const uint16_t currentSaveFileVersion = Game::GetVersionOfCurrentSaveFile();
+        Game::SetVersionOfCurrentSaveFile( _formatVersion );
+
+        for ( Maps::Tiles & tile : tiles ) {
+            dataStream >> tile;
+        }
+
+        Game::SetVersionOfCurrentSaveFile( currentSaveFileVersion );
+    }
+
+    for ( uint32_t i = 0; i < changedTileCount; ++i ) {
+        Maps::Tiles tile;
+        stream >> tile;
+
+        const int32_t tileIndex = tile.GetIndex();
+        if ( stream.fail() || tileIndex < 0 || static_cast<size_t>( tileIndex ) >= tiles.size() ) {
+            ERROR_LOG( "Invalid changed tile " << tileIndex )
+            return false;
+        }
+
+        tiles[tileIndex] = std::move( tile );
+    }
+
+    return true;
+}
+
+std::string WorldBaseTiles::getFileName( const uint32_t mapSeed, const uint32_t checksum )
+{
+    return std::to_string( mapSeed ) + '_' + std::to_string( checksum ) + ".base";
+}
+
+bool WorldBaseTiles::hasStoredFiles()
+{
+    return !ListFiles::IsEmpty( getBaseTilesDirectory(), ".base" );
+}
+
+void WorldBaseTiles::removeUnusedFiles( const std::set<std::string> & usedFileNames )
+{
+    ListFiles files;
+    files.ReadDir( getBaseTilesDirectory(), ".base" );
+
+    for ( const std::string & filePath : files ) {
+        if ( usedFileNames.count( System::GetBasename( filePath ) ) > 0 ) {
+            continue;
+        }
+
+        if ( System::Unlink( filePath ) ) {
+            DEBUG_LOG( DBG_GAME, DBG_INFO, "Removed unused base tiles " << filePath )
+        }
+        else {
+            ERROR_LOG( "Failed to remove the file " << filePath )
+        }
+    }
+}
+
+std::string WorldBaseTiles::getFilePath() const
+{
+    return System::concatPath( getBaseTilesDirectory(), getFileName( _mapSeed, _checksum ) );
+}
@@ -0,0 +1,112 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2024                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "save_format_version.h"
+
+class IStreamBase;
+class OStreamBase;
+
+namespace Maps
+{
+    class Tiles;
+}
+
+// The state of all map tiles at the time of the first delta save of the game. It is kept in a separate file in the save directory,
+// so saves of the same game can refer to it and store only the tiles that have changed since then.
+class WorldBaseTiles
+{
+public:
+    WorldBaseTiles() = default;
+    WorldBaseTiles( const WorldBaseTiles & ) = delete;
+
+    ~WorldBaseTiles() = default;
+
+    WorldBaseTiles & operator=( const WorldBaseTiles & ) = delete;
+
+    void capture( const std::vector<Maps::Tiles> & tiles, const uint32_t mapSeed );
+
+    void reset();
+
+    bool isValid() const
+    {
+        return !_data.empty();
+    }
+
+    bool isStored() const
+    {
+        return _isStored;
+    }
+
+    uint32_t getMapSeed() const
+    {
+        return _mapSeed;
+    }
+
+    uint32_t getChecksum() const
+    {
+        return _checksum;
+    }
+
+    // Writes the base tiles to the disk if this has not been done yet. Returns false if they are not available on the disk.
+    bool store();
+
+    // Reads the base tiles with the given identifiers from the disk unless they are already loaded
+    bool load( const uint32_t mapSeed, const uint32_t checksum );
+
+    // Writes only the tiles which differ from the base ones
+    void writeChangedTiles( OStreamBase & stream, const std::vector<Maps::Tiles> & tiles ) const;
+
+    // Restores all tiles from the base ones and applies the changed tiles read from the stream
+    bool readChangedTiles( IStreamBase & stream, std::vector<Maps::Tiles> & tiles );
+
+    // Returns the name of the file in which the base tiles with the given identifiers are stored
+    static std::string getFileName( const uint32_t mapSeed, const uint32_t checksum );
+
+    // Returns true if there is at least one file of base tiles on the disk
+    static bool hasStoredFiles();
+
+    // Removes the files of the base tiles which are not in the given list of file names
+    static void removeUnusedFiles( const std::set<std::string> & usedFileNames );
+
+private:
+    std::string getFilePath() const;
+
+    // Serialized tiles
+    std::vector<uint8_t> _data;
+
+    // Offsets of every serialized tile within the data, followed by the size of the data
+    std::vector<size_t> _offsets;
+
+    uint32_t _mapSeed{ 0 };
+    uint32_t _checksum{ 0 };
+
+    // Version of the save file format used to serialize the tiles
+    uint16_t _formatVersion{ CURRENT_FORMAT_VERSION };
+
+    bool _isStored{ false };
+};
@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -62,6 +63,7 @@
 #include "resource.h"
 #include "serialize.h"
 #include "settings.h"
+#include "timing.h"
 #include "world.h" // IWYU pragma: associated
 #include "world_object_uid.h"
 
@@ -234,59 +236,84 @@ bool World::LoadMapMP2( const std::string & filename, const bool isOriginalMp2Fi
 
     const bool checkPoLObjects = !Settings::Get().isPriceOfLoyaltySupported() && isOriginalMp2File;
 
-    MapsIndexes vec_object; // index maps for OBJ_CASTLE, OBJ_HERO, OBJ_SIGN, OBJ_BOTTLE, OBJ_EVENT
-    vec_object.reserve( 128 );
+    fheroes2::Time timer;
 
-    for ( int32_t i = 0; i < worldSize; ++i ) {
-        Maps::Tiles & tile = vec_tiles[i];
-
-        MP2::MP2TileInfo mp2tile;
-        MP2::loadTile( fs, mp2tile );
-        // There are some tiles which have object type as 65 and 193 which are Thatched Hut. This is exactly the same object as Peasant Hut.
-        // Since the original number of object types is limited and in order not to confuse players we will convert this type into Peasant Hut.
-        if ( mp2tile.mapObjectType == 65 ) {
-            mp2tile.mapObjectType = MP2::OBJ_NON_ACTION_PEASANT_HUT;
-        }
-        else if ( mp2tile.mapObjectType == 193 ) {
-            mp2tile.mapObjectType = MP2::OBJ_PEASANT_HUT;
-        }
+    // All MP2 tiles are read at once and then every tile is initialized independently in multiple threads.
+    const std::vector<uint8_t> mp2TileData = fs.getRaw( static_cast<size_t>( worldSize ) * MP2::MP2_TILE_STRUCTURE_SIZE );
+    if ( mp2TileData.size() != static_cast<size_t>( worldSize ) * MP2::MP2_TILE_STRUCTURE_SIZE ) {
+        DEBUG_LOG( DBG_GAME, DBG_WARN, "Map file " << filename << " is corrupted" )
+        return false;
+    }
 
-        if ( checkPoLObjects ) {
-            switch ( mp2tile.mapObjectType ) {
-            case MP2::OBJ_BARRIER:
-            case MP2::OBJ_EXPANSION_DWELLING:
-            case MP2::OBJ_EXPANSION_OBJECT:
-            case MP2::OBJ_JAIL:
-            case MP2::OBJ_TRAVELLER_TENT:
-                ERROR_LOG( "Failed to load The Price of Loyalty map '" << filename << "' which is not supported by this version of the game." )
-                // You are trying to load a PoL map named as a MP2 file.
-                return false;
-            default:
-                break;
+    std::atomic<bool> isPoLObjectFound{ false };
+
+    processTilesInParallel( [this, &mp2TileData, &vec_mp2addons, &isPoLObjectFound, checkPoLObjects]( const int32_t begin, const int32_t end ) {
+        ROStreamBuf tileStream( mp2TileData );
+        tileStream.seek( static_cast<size_t>( begin ) * MP2::MP2_TILE_STRUCTURE_SIZE );
+
+        for ( int32_t i = begin; i < end; ++i ) {
+            Maps::Tiles & tile = vec_tiles[i];
+
+            MP2::MP2TileInfo mp2tile;
+            MP2::loadTile( tileStream, mp2tile );
+            // There are some tiles which have object type as 65 and 193 which are Thatched Hut. This is exactly the same object as Peasant Hut.
+            // Since the original number of object types is limited and in order not to confuse players we will convert this type into Peasant Hut.
+            if ( mp2tile.mapObjectType == 65 ) {
+                mp2tile.mapObjectType = MP2::OBJ_NON_ACTION_PEASANT_HUT;
+            }
+            else if ( mp2tile.mapObjectType == 193 ) {
+                mp2tile.mapObjectType = MP2::OBJ_PEASANT_HUT;
             }
-        }
 
-        tile.Init( i, mp2tile );
+            if ( checkPoLObjects ) {
+                switch ( mp2tile.mapObjectType ) {
+                case MP2::OBJ_BARRIER:
+                case MP2::OBJ_EXPANSION_DWELLING:
+                case MP2::OBJ_EXPANSION_OBJECT:
+                case MP2::OBJ_JAIL:
+                case MP2::OBJ_TRAVELLER_TENT:
+                    // You are trying to load a PoL map named as a MP2 file.
+                    isPoLObjectFound = true;
+                    return;
+                default:
+                    break;
+                }
+            }
 
-        // Read extra information if it's present.
-        size_t addonIndex = mp2tile.nextAddonIndex;
-        while ( addonIndex > 0 ) {
-            if ( vec_mp2addons.size() <= addonIndex ) {
-                DEBUG_LOG( DBG_GAME, DBG_WARN, "Invalid MP2 format: incorrect addon index " << addonIndex )
-                break;
+            tile.Init( i, mp2tile );
+
+            // Read extra information if it's present.
+            size_t addonIndex = mp2tile.nextAddonIndex;
+            while ( addonIndex > 0 ) {
+                if ( vec_mp2addons.size() <= addonIndex ) {
+                    DEBUG_LOG( DBG_GAME, DBG_WARN, "Invalid MP2 format: incorrect addon index " << addonIndex )
+                    break;
+                }
+                tile.pushBottomLayerAddon( vec_mp2addons[addonIndex] );
+                tile.pushTopLayerAddon( vec_mp2addons[addonIndex] );
+                addonIndex = vec_mp2addons[addonIndex].nextAddonIndex;
             }
-            tile.pushBottomLayerAddon( vec_mp2addons[addonIndex] );
-            tile.pushTopLayerAddon( vec_mp2addons[addonIndex] );
-            addonIndex = vec_mp2addons[addonIndex].nextAddonIndex;
+
+            tile.AddonsSort();
         }
+    } );
 
-        tile.AddonsSort();
+    if ( isPoLObjectFound ) {
+        ERROR_LOG( "Failed to load The Price of Loyalty map '" << filename << "' which is not supported by this version of the game." )
+        return false;
+    }
+
+    MapsIndexes vec_object; // index maps for OBJ_CASTLE, OBJ_HERO, OBJ_SIGN, OBJ_BOTTLE, OBJ_EVENT
+    vec_object.reserve( 128 );
 
-        if ( MP2::doesObjectNeedExtendedMetadata( tile.GetObject() ) ) {
+    for ( int32_t i = 0; i < worldSize; ++i ) {
+        if ( MP2::doesObjectNeedExtendedMetadata( vec_tiles[i].GetObject() ) ) {
             vec_object.push_back( i );
         }
     }
 
+    DEBUG_LOG( DBG_GAME, DBG_INFO, "Initialized " << worldSize << " tiles in " << timer.getMs() << " ms" )
+
     // If this assertion blows up it means that we are not reading the data properly from the file.
     assert( fs.tell() == MP2::MP2_MAP_INFO_SIZE + static_cast<size_t>( worldSize ) * MP2::MP2_TILE_STRUCTURE_SIZE );
 
@@ -1123,9 +1150,21 @@ bool World::loadResurrectionMap( const std::string & filename )
 
 bool World::ProcessNewMP2Map( const std::string & filename, const bool checkPoLObjects )
 {
-    for ( Maps::Tiles & tile : vec_tiles ) {
-        Maps::Tiles::fixMP2MapTileObjectType( tile );
+    fheroes2::Time timer;
+
+    // Object types are fixed for every tile independently.
+    processTilesInParallel( [this]( const int32_t begin, const int32_t end ) {
+        for ( int32_t i = begin; i < end; ++i ) {
+            Maps::Tiles::fixMP2MapTileObjectType( vec_tiles[i] );
+        }
+    } );
+
+    DEBUG_LOG( DBG_GAME, DBG_INFO, "Fixed object types of tiles in " << timer.getMs() << " ms" )
+
+    timer.reset();
 
+    // Metadata updates create map objects and use the random number generator, so they must be done in the order of tiles.
+    for ( Maps::Tiles & tile : vec_tiles ) {
         if ( !updateTileMetadata( tile, tile.GetObject(), checkPoLObjects ) ) {
             ERROR_LOG( "Failed to load The Price of Loyalty map '" << filename << "' which is not supported by this version of the game." )
             // You are trying to load a PoL map named as a MP2 file.
@@ -1133,6 +1172,8 @@ bool World::ProcessNewMP2Map( const std::string & filename, const bool checkPoLO
         }
     }
 
+    DEBUG_LOG( DBG_GAME, DBG_INFO, "Updated metadata of tiles in " << timer.getMs() << " ms" )
+
     // add heroes to kingdoms
     vec_kingdoms.AddHeroes( vec_heroes );
 
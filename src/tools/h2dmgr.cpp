@@ -66,7 +66,9 @@ namespace
 
         std::cerr << baseName << " manages the contents of the specified H2D file(s)." << std::endl
                   << "Syntax: " << baseName << " extract dst_dir palette_file.pal input_file.h2d ..." << std::endl
-                  << "        " << baseName << " combine target_file.h2d palette_file.pal input_file ..." << std::endl;
+                  << "        " << baseName << " combine target_file.h2d palette_file.pal input_file ..." << std::endl
+                  << "        " << baseName << " convert target_file.h2d input_file.h2d" << std::endl
+                  << "The target file is always written in the latest version of the H2D format with compression of items where possible." << std::endl;
     }
 
     bool loadPalette( const char * paletteFileName )
@@ -314,6 +316,34 @@ namespace
 
         return EXIT_SUCCESS;
     }
+
+    // The caller has to make sure that 'argv' contains at least 4 arguments
+    int convertH2D( char ** argv )
+    {
+        const char * h2dFileName = argv[2];
+        const char * inputFileName = argv[3];
+
+        fheroes2::H2DReader reader;
+        if ( !reader.open( inputFileName ) ) {
+            std::cerr << "Cannot open file " << inputFileName << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        fheroes2::H2DWriter writer;
+        if ( !writer.add( reader ) ) {
+            std::cerr << "Error reading from file " << inputFileName << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        if ( !writer.write( h2dFileName ) ) {
+            std::cerr << "Error writing to file " << h2dFileName << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "Total converted items: " << reader.getAllFileNames().size() << std::endl;
+
+        return EXIT_SUCCESS;
+    }
 }
 
 int main( int argc, char ** argv )
@@ -326,6 +356,10 @@ int main( int argc, char ** argv )
         return combineH2D( argc, argv );
     }
 
+    if ( argc == 4 && strcmp( argv[1], "convert" ) == 0 ) {
+        return convertH2D( argv );
+    }
+
     printUsage( argv );
 
     return EXIT_FAILURE;